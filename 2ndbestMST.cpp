@@ -2,147 +2,386 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <climits>
+#include <queue>
+#include <tuple>
+
+#include "csr.h"
+#include "edge_input.h"
+#include "mst.h"
 
 using namespace std;
 
-const int INF = 1e9;
+const int NO_WEIGHT = INT_MIN; // Empty slot in a Top2
 
 struct Edge {
     int u, v, w;
     int id; // Optional: helps if we need to track original indices
 };
 
-bool comparator(const Edge &a, const Edge &b) {
-    return a.w < b.w;
-}
-
-struct DSU {
-    vector<int> parent, rnk;
-    int num_components; // Track components to check connectivity
+// Largest and strictly second-largest edge weight on a stretch of tree path
+struct Top2 {
+    int first = NO_WEIGHT, second = NO_WEIGHT;
 
-    DSU(int n) {
-        parent.resize(n + 1); // 1-based indexing safety
-        rnk.assign(n + 1, 0);
-        num_components = n;
-        for (int i = 0; i <= n; i++) { parent[i] = i; }
+    void add(int w) {
+        if (w > first) {
+            second = first;
+            first = w;
+        } else if (w < first && w > second) {
+            second = w;
+        }
     }
 
-    int find_set(int v) {
-        if (parent[v] == v) return v;
-        return parent[v] = find_set(parent[v]);
+    void add(const Top2& o) {
+        add(o.first);
+        add(o.second);
     }
+};
 
-    bool unite(int a, int b) {
-        a = find_set(a);
-        b = find_set(b);
-        if (a == b) return false;
-        
-        num_components--; // Decrement component count
-        
-        if (rnk[a] < rnk[b]) swap(a, b);
-        parent[b] = a;
-        if (rnk[a] == rnk[b]) rnk[a]++;
-        return true;
-    }
+// One 2^k jump: the ancestor reached and the Top2 of the edges skipped
+struct Jump {
+    int up;
+    Top2 top;
 };
 
-// Global MST Adjacency List for DFS traversal
-// Stores pairs of {neighbor, weight}
-vector<pair<int, int>> mst_adj[505]; 
-
-// DFS to find the path between u and target in the MST
-// Stores the weights of edges on the path in 'path_weights'
-bool getPath(int u, int target, int p, vector<int>& path_weights) {
-    if (u == target) return true;
-
-    for (auto &edge : mst_adj[u]) {
-        int v = edge.first;
-        int w = edge.second;
-        if (v != p) {
-            path_weights.push_back(w); // Add edge weight to path
-            if (getPath(v, target, u, path_weights)) return true; // Found target
-            path_weights.pop_back(); // Backtrack
+// Binary lifting over the MST: jump[k][v] covers the 2^k edges above v
+int LOG;
+vector<int> depth;
+vector<vector<Jump>> jump;
+
+// Root the spanning tree at node 1 with an iterative BFS over the CSR (no
+// recursion, so N = 10^6 paths are fine), then fill the levels one by one
+void build_lifting(int n, const CSRGraph<int>& mst_adj) {
+    LOG = 1;
+    while ((1 << LOG) < n) LOG++;
+
+    depth.assign(n + 1, 0);
+    jump.assign(LOG, vector<Jump>(n + 1));
+
+    vector<int> order;
+    order.reserve(n);
+    vector<bool> seen(n + 1, false);
+    order.push_back(1);
+    seen[1] = true;
+    jump[0][1] = {1, Top2()};
+    for (size_t head = 0; head < order.size(); head++) {
+        int u = order[head];
+        for (uint32_t a = mst_adj.begin(u); a < mst_adj.end(u); a++) {
+            int v = mst_adj.target[a];
+            if (seen[v]) continue;
+            seen[v] = true;
+            depth[v] = depth[u] + 1;
+            jump[0][v].up = u;
+            jump[0][v].top.add(mst_adj.data[a]);
+            order.push_back(v);
+        }
+    }
+
+    for (int k = 1; k < LOG; k++) {
+        const vector<Jump>& half = jump[k - 1];
+        vector<Jump>& full = jump[k];
+        for (int v = 1; v <= n; v++) {
+            const Jump& a = half[v];
+            const Jump& b = half[a.up];
+            full[v].up = b.up;
+            full[v].top = a.top;
+            full[v].top.add(b.top);
         }
     }
-    return false;
 }
 
-void solve_second_best_mst(int n, vector<Edge> &edges) {
-    sort(edges.begin(), edges.end(), comparator);
+// Top2 of the edge weights on the MST path between u and v, O(log N)
+Top2 path_top2(int u, int v) {
+    Top2 res;
+    if (depth[u] < depth[v]) swap(u, v);
+
+    // 1. Lift u to the same depth as v
+    for (int k = LOG - 1; k >= 0; k--) {
+        if (depth[u] - (1 << k) >= depth[v]) {
+            res.add(jump[k][u].top);
+            u = jump[k][u].up;
+        }
+    }
+    if (u == v) return res;
 
-    DSU dsu(n);
+    // 2. Lift both until they are just below the LCA
+    for (int k = LOG - 1; k >= 0; k--) {
+        if (jump[k][u].up != jump[k][v].up) {
+            res.add(jump[k][u].top);
+            res.add(jump[k][v].top);
+            u = jump[k][u].up;
+            v = jump[k][v].up;
+        }
+    }
+
+    // 3. The final edges into the LCA
+    res.add(jump[0][u].top);
+    res.add(jump[0][v].top);
+    return res;
+}
+
+void solve_second_best_mst(int n, vector<Edge> &edges, const MSTOptions &opt) {
     long long mstWeight = 0;
-    vector<Edge> unused_edges;
     int edges_count = 0;
 
-    // --- Step 1: Standard Kruskal's to build MST ---
-    for (auto &edge : edges) {
-        if (dsu.unite(edge.u, edge.v)) {
-            mstWeight += edge.w;
-            edges_count++;
-            
-            // Build the MST graph for traversal later (Undirected = add both ways)
-            mst_adj[edge.u].push_back({edge.v, edge.w});
-            mst_adj[edge.v].push_back({edge.u, edge.w});
-        } else {
-            // If adding this edge creates a cycle, it's a candidate for the 2nd best MST
-            unused_edges.push_back(edge);
-        }
+    // --- Step 1: Build the MST with the selected engine ---
+    vector<uint32_t> tree = build_mst(opt, edges, n, [](const Edge& e) { return e.w; });
+
+    vector<bool> in_tree(edges.size(), false);
+    for (uint32_t pos : tree) {
+        const Edge &edge = edges[pos];
+        in_tree[pos] = true;
+        mstWeight += edge.w;
+        edges_count++;
     }
 
     // Check if a valid MST even exists
     if (edges_count < n - 1) {
-        cout << "-1" << endl;
+        cout << "-1\n";
         return;
     }
 
+    // MST graph for the BFS (Undirected = both directions)
+    CSRGraph<int> mst_adj;
+    mst_adj.build(n + 1, tree.size(), [&](size_t k) {
+        const Edge &edge = edges[tree[k]];
+        return CSREdge<int>{edge.u, edge.v, edge.w};
+    });
+    if (n >= 1) build_lifting(n, mst_adj);
+
     // --- Step 2: Find Strictly Second Best MST ---
     long long min_diff = -1; // -1 indicates no valid strictly greater tree found yet
 
-    // Try adding every unused edge
-    for (const auto &new_edge : unused_edges) {
-        vector<int> path_weights;
-        // Find the path in the MST between the two endpoints of the unused edge
-        getPath(new_edge.u, new_edge.v, -1, path_weights);
-
-        // We want to remove an edge from the cycle (path_weights) 
-        // such that new_total > mstWeight.
-        // new_total = mstWeight - removed_w + new_edge.w
-        // Condition: new_edge.w > removed_w
-        
-        for (int w_removed : path_weights) {
-            if (new_edge.w > w_removed) {
-                long long diff = new_edge.w - w_removed;
-                
-                // We want the smallest positive difference
-                if (min_diff == -1 || diff < min_diff) {
-                    min_diff = diff;
-                }
-            }
+    // Every edge left out of the tree closes a cycle with its MST path.
+    // Swapping it for a path edge of weight w_removed < new_edge.w gives
+    // new_total = mstWeight - w_removed + new_edge.w > mstWeight, and the best
+    // w_removed is the largest path weight below new_edge.w. The MST property
+    // means new_edge.w >= the path maximum, so that is the maximum itself,
+    // or the strictly second largest when they are equal.
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (in_tree[i]) continue;
+        const Edge &new_edge = edges[i];
+        Top2 top = path_top2(new_edge.u, new_edge.v);
+
+        int w_removed = new_edge.w > top.first ? top.first : top.second;
+        if (w_removed == NO_WEIGHT) continue; // Self-loop, or no lighter edge on the cycle
+
+        long long diff = (long long)new_edge.w - w_removed;
+        // We want the smallest positive difference
+        if (min_diff == -1 || diff < min_diff) {
+            min_diff = diff;
         }
     }
 
     if (min_diff == -1) {
-        cout << "-1" << endl;
+        cout << "-1\n";
     } else {
-        cout << mstWeight + min_diff << endl;
+        cout << mstWeight + min_diff << "\n";
     }
 }
 
-int main() {
+// ---------------------------------------------------------------------------
+// k cheapest spanning trees (--k-best=K), Katoh-Ibaraki-Mine style.
+//
+// Every subproblem is "spanning trees that contain the forced-in edges and
+// avoid the forced-out ones", together with its MST T and its best single
+// swap (remove tree edge f, add non-tree edge e) within the constraints. The
+// cheapest unreported tree overall is T - f + e of the subproblem with the
+// smallest weight(T) + w(e) - w(f). When it is popped it is reported, and the
+// subproblem splits into "f forced in" (MST still T) and "f forced out" (MST
+// is T - f + e). Each split evaluates the best swap for its two children, so
+// the next tree costs O(M alpha(N) + N), not a fresh search.
+//
+// Subproblems are stored as a chain of (constraint, swap) deltas from the
+// MST rather than as whole trees, so memory is O(K) on top of the graph.
+
+const uint32_t NO_EDGE = UINT32_MAX;
+
+struct KBestNode {
+    int parent;              // -1 for the MST itself
+    uint32_t removed, added; // Swap applied to the parent's tree (NO_EDGE if none)
+    uint32_t constraint;     // Edge forced in or out here (NO_EDGE for the root)
+    bool forced_in;
+    int rank;                // Output rank of this subproblem's tree
+    long long weight;
+};
+
+struct KBestSwap {
+    long long delta;
+    uint32_t removed, added;
+};
+
+struct KBestEnumerator {
+    int n;
+    const vector<Edge>& edges;
+    vector<uint32_t> by_weight; // All edge ids, ascending weight
+    vector<char> mst_flag;
+    vector<KBestNode> nodes;
+
+    // Scratch for evaluate()
+    vector<char> in_tree, state; // state: 0 free, 1 forced in, 2 forced out
+    vector<uint32_t> tree_ids, parent_edge, cover;
+    vector<int> parent_node, depth, jump, order;
+    CSRGraph<uint32_t> tree_adj; // Arc data = edge id
+
+    KBestEnumerator(int n, const vector<Edge>& edges, const vector<uint32_t>& mst) : n(n), edges(edges) {
+        by_weight = radix_sort_order(edges, [](const Edge& e) { return e.w; });
+        mst_flag.assign(edges.size(), 0);
+        for (uint32_t pos : mst) mst_flag[pos] = 1;
+    }
+
+    int find(int x) {
+        while (jump[x] != x) {
+            jump[x] = jump[jump[x]];
+            x = jump[x];
+        }
+        return x;
+    }
+
+    // Best swap of subproblem x, false if its tree is the only one left
+    bool evaluate(int x, KBestSwap& best) {
+        // Replay the deltas from the MST down to x
+        in_tree = mst_flag;
+        state.assign(edges.size(), 0);
+        vector<int> chain;
+        for (int y = x; y != -1; y = nodes[y].parent) chain.push_back(y);
+        for (int i = chain.size() - 1; i >= 0; i--) {
+            const KBestNode& node = nodes[chain[i]];
+            if (node.removed != NO_EDGE) {
+                in_tree[node.removed] = 0;
+                in_tree[node.added] = 1;
+            }
+            if (node.constraint != NO_EDGE) state[node.constraint] = node.forced_in ? 1 : 2;
+        }
+
+        tree_ids.clear();
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (in_tree[i]) tree_ids.push_back(i);
+        }
+        tree_adj.build(n + 1, tree_ids.size(), [&](size_t k) {
+            const Edge& e = edges[tree_ids[k]];
+            return CSREdge<uint32_t>{e.u, e.v, tree_ids[k]};
+        });
+
+        // Root the tree at 1
+        parent_node.assign(n + 1, 0);
+        parent_edge.assign(n + 1, NO_EDGE);
+        depth.assign(n + 1, 0);
+        order.assign(1, 1);
+        parent_node[1] = 1;
+        for (size_t head = 0; head < order.size(); head++) {
+            int u = order[head];
+            for (uint32_t a = tree_adj.begin(u); a < tree_adj.end(u); a++) {
+                int v = tree_adj.target[a];
+                if (v == parent_node[u] && tree_adj.data[a] == parent_edge[u]) continue;
+                parent_node[v] = u;
+                parent_edge[v] = tree_adj.data[a];
+                depth[v] = depth[u] + 1;
+                order.push_back(v);
+            }
+        }
+
+        // Cover every tree edge with the lightest allowed non-tree edge whose
+        // cycle contains it. jump[] skips over edges that are already covered.
+        jump.resize(n + 1);
+        iota(jump.begin(), jump.end(), 0);
+        cover.assign(n + 1, NO_EDGE);
+        int uncovered = n - 1;
+        for (uint32_t id : by_weight) {
+            if (uncovered == 0) break;
+            if (in_tree[id] || state[id] == 2) continue;
+            int a = find(edges[id].u), b = find(edges[id].v);
+            while (a != b) {
+                if (depth[a] < depth[b]) swap(a, b);
+                cover[a] = id;
+                uncovered--;
+                jump[a] = parent_node[a];
+                a = find(a);
+            }
+        }
+
+        bool found = false;
+        for (int v = 2; v <= n; v++) {
+            uint32_t f = parent_edge[v];
+            if (cover[v] == NO_EDGE || state[f] == 1) continue;
+            long long delta = (long long)edges[cover[v]].w - edges[f].w;
+            if (!found || delta < best.delta) best = {delta, f, cover[v]};
+            found = true;
+        }
+        return found;
+    }
+
+    // Report the K cheapest trees: "rank weight", then for every further
+    // tree "rank weight parent_rank removed_edge added_edge" (1-based edge
+    // numbers): that tree is the parent tree with one edge swapped
+    void run(long long mst_weight, int K, ostream& out) {
+        if (K <= 0) return;
+        out << 1 << " " << mst_weight << "\n";
+
+        // (weight, node, swap); ties go to the older subproblem
+        using Entry = tuple<long long, int, KBestSwap>;
+        auto later = [](const Entry& a, const Entry& b) {
+            return get<0>(a) != get<0>(b) ? get<0>(a) > get<0>(b) : get<1>(a) > get<1>(b);
+        };
+        priority_queue<Entry, vector<Entry>, decltype(later)> pq(later);
+        auto push = [&](int x) {
+            KBestSwap s;
+            if (evaluate(x, s)) pq.push({nodes[x].weight + s.delta, x, s});
+        };
+
+        nodes.push_back({-1, NO_EDGE, NO_EDGE, NO_EDGE, false, 1, mst_weight});
+        push(0);
+
+        for (int rank = 2; rank <= K && !pq.empty(); rank++) {
+            auto [weight, x, s] = pq.top();
+            pq.pop();
+            out << rank << " " << weight << " " << nodes[x].rank << " " << s.removed + 1 << " " << s.added + 1 << "\n";
+            out.flush(); // Stream each tree as soon as it is known
+
+            int keep = nodes.size();
+            nodes.push_back({x, NO_EDGE, NO_EDGE, s.removed, true, nodes[x].rank, nodes[x].weight});
+            nodes.push_back({x, s.removed, s.added, s.removed, false, rank, weight});
+            push(keep);
+            push(keep + 1);
+        }
+    }
+};
+
+int main(int argc, char** argv) {
     // Fast I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n, m;
-    if (!(cin >> n >> m)) return 0;
+    // --k-best=K: stream the K cheapest spanning trees instead (K >= 1)
+    const char* k_flag = flag_value(argc, argv, "--k-best");
+    int K = 0;
+    if (k_flag && (!parse_int(k_flag, K) || K < 1)) {
+        cerr << "--k-best needs a positive integer, got '" << k_flag << "'\n";
+        return 1;
+    }
+
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    int n;
+    vector<Edge> edges;
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, n, edges)) return 0;
 
-    vector<Edge> edges(m);
-    for (int i = 0; i < m; i++) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
+    // --engine=kruskal|filter|boruvka, --threads=N, --stats (see mst.h)
+    MSTOptions opt = parse_mst_options(argc, argv);
+
+    if (k_flag) {
+        vector<uint32_t> tree = build_mst(opt, edges, n, [](const Edge& e) { return e.w; });
+        if ((int)tree.size() < n - 1) {
+            cout << "-1\n";
+            return 0;
+        }
+        long long mst_weight = 0;
+        for (uint32_t pos : tree) mst_weight += edges[pos].w;
+        KBestEnumerator(n, edges, tree).run(mst_weight, K, cout);
+        return 0;
     }
 
-    solve_second_best_mst(n, edges);
+    solve_second_best_mst(n, edges, opt);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "binary_lifting.h"
+#include "csr.h"
+#include "hld.h"
+#include "krt.h"
+
+using namespace std;
+
+// Path-max query throughput of the indexes queryviabinlift.cpp can use
+// (binary_lifting.h in both layouts, hld.h, krt.h), and of the old per-node
+// nested lifting tables (vector<vector<int>> up, max_w with a fixed LOG = 20)
+// Usage: bench_binlift [n] [q]   (default n = 10^6, q = 10^7)
+//
+// random: every node hangs below a uniformly random earlier node (depth ~ log n)
+// path  : one long path (depth n - 1)
+// Node labels are shuffled in both, like an MST read from input.
+
+using Clock = chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// The layout queryviabinlift.cpp used before (built by BFS here, since its
+// recursive DFS overflows the stack on the path tree)
+struct NestedLifting {
+    static const int LOG = 20;
+    vector<int> depth;
+    vector<vector<int>> up, max_w;
+
+    void build(int n, const CSRGraph<int>& tree) {
+        depth.assign(n + 1, 0);
+        up.assign(n + 1, vector<int>(LOG));
+        max_w.assign(n + 1, vector<int>(LOG));
+        vector<int> order(1, 1);
+        vector<bool> seen(n + 1, false);
+        seen[1] = true;
+        up[1][0] = 1;
+        for (size_t head = 0; head < order.size(); head++) {
+            int u = order[head];
+            for (int i = 1; i < LOG; i++) {
+                up[u][i] = up[up[u][i - 1]][i - 1];
+                max_w[u][i] = max(max_w[u][i - 1], max_w[up[u][i - 1]][i - 1]);
+            }
+            for (uint32_t a = tree.begin(u); a < tree.end(u); a++) {
+                int v = tree.target[a];
+                if (seen[v]) continue;
+                seen[v] = true;
+                depth[v] = depth[u] + 1;
+                up[v][0] = u;
+                max_w[v][0] = tree.data[a];
+                order.push_back(v);
+            }
+        }
+    }
+
+    int path_max(int u, int v) const {
+        if (depth[u] < depth[v]) swap(u, v);
+        int res = 0;
+        for (int i = LOG - 1; i >= 0; i--) {
+            if (depth[u] - (1 << i) >= depth[v]) {
+                res = max(res, max_w[u][i]);
+                u = up[u][i];
+            }
+        }
+        if (u == v) return res;
+        for (int i = LOG - 1; i >= 0; i--) {
+            if (up[u][i] != up[v][i]) {
+                res = max({res, max_w[u][i], max_w[v][i]});
+                u = up[u][i];
+                v = up[v][i];
+            }
+        }
+        return max({res, max_w[u][0], max_w[v][0]});
+    }
+};
+
+template <typename Index>
+void run(const string& name, int n, const CSRGraph<int>& tree, const vector<pair<int, int>>& queries) {
+    auto start = Clock::now();
+    Index index;
+    index.build(n, tree);
+    double build_time = seconds_since(start);
+
+    start = Clock::now();
+    long long checksum = 0;
+    for (const auto& q : queries) checksum += index.path_max(q.first, q.second);
+    double query_time = seconds_since(start);
+
+    cout << "  " << name << ": build " << build_time << " s, " << (queries.size() / query_time / 1e6)
+         << " M queries/s (checksum " << checksum << ")\n";
+}
+
+// The nested version reports 0 for u == v; match it so the checksums agree
+template <LiftLayout Layout>
+struct Flat : BinaryLifting<int, Layout> {
+    int path_max(int u, int v) const { return u == v ? 0 : BinaryLifting<int, Layout>::path_max(u, v); }
+};
+
+template <typename W>
+struct HLDIndex : HeavyLight<W> {
+    W path_max(int u, int v) const { return u == v ? 0 : HeavyLight<W>::path_max(u, v); }
+};
+
+// KruskalTree wants the tree edges in Kruskal order instead of a CSR graph
+struct KRTIndex : KruskalTree<int> {
+    void build(int n, const CSRGraph<int>& tree) {
+        vector<CSREdge<int>> edges;
+        for (int x = 1; x <= n; x++) {
+            for (uint32_t a = tree.begin(x); a < tree.end(x); a++) {
+                if (x < tree.target[a]) edges.push_back({x, tree.target[a], tree.data[a]});
+            }
+        }
+        sort(edges.begin(), edges.end(), [](const CSREdge<int>& a, const CSREdge<int>& b) { return a.data < b.data; });
+        KruskalTree<int>::build(n, edges.size(), [&](size_t k) {
+            struct { int u, v, w; } e{edges[k].u, edges[k].v, edges[k].data};
+            return e;
+        });
+    }
+    int path_max(int u, int v) const { return u == v ? 0 : KruskalTree<int>::path_max(u, v); }
+};
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? stoi(argv[1]) : 1000000;
+    long long q = argc > 2 ? stoll(argv[2]) : 10000000;
+
+    mt19937 rng(12345);
+    vector<int> label(n + 1);
+    for (int i = 0; i <= n; i++) label[i] = i;
+    shuffle(label.begin() + 1, label.end(), rng);
+    uniform_int_distribution<int> weight(0, 1000000000), node(1, n);
+
+    vector<pair<int, int>> queries(q);
+    for (auto& x : queries) x = {node(rng), node(rng)};
+
+    for (string shape : {"random", "path"}) {
+        vector<CSREdge<int>> edges;
+        for (int i = 2; i <= n; i++) {
+            int parent = shape == "path" ? i - 1 : uniform_int_distribution<int>(1, i - 1)(rng);
+            edges.push_back({label[parent], label[i], weight(rng)});
+        }
+        CSRGraph<int> tree;
+        tree.build(n + 1, edges.size(), [&](size_t k) { return edges[k]; });
+
+        cout << shape << " tree, n = " << n << ", q = " << q << "\n";
+        run<NestedLifting>("nested      ", n, tree, queries);
+        run<Flat<LiftLayout::LevelMajor>>("level-major ", n, tree, queries);
+        run<Flat<LiftLayout::NodeMajor>>("node-major  ", n, tree, queries);
+        run<HLDIndex<int>>("hld         ", n, tree, queries);
+        run<KRTIndex>("krt         ", n, tree, queries);
+    }
+
+    return 0;
+}
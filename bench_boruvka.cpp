@@ -0,0 +1,55 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "mst.h"
+
+using namespace std;
+
+// Strong-scaling benchmark for the Borůvka engine: fixed graph, 1..N threads
+// Usage: bench_boruvka [n] [m] [max_threads]   (default: 10^6 nodes, 10^7 edges, all cores)
+
+struct Edge {
+    int u, v, w;
+};
+
+using Clock = chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? stoi(argv[1]) : 1000000;
+    long long m = argc > 2 ? stoll(argv[2]) : 10000000;
+    unsigned max_threads = argc > 3 ? stoul(argv[3]) : default_thread_count();
+
+    mt19937 rng(12345);
+    uniform_int_distribution<int> node(1, n), weight(0, 1000000000);
+    vector<Edge> edges(m);
+    for (auto& e : edges) e = {node(rng), node(rng), weight(rng)};
+
+    auto weight_of = [](const Edge& e) { return e.w; };
+
+    auto start = Clock::now();
+    vector<uint32_t> reference = kruskal_tree(edges, n, weight_of);
+    double kruskal_time = seconds_since(start);
+    cout << "n = " << n << ", m = " << m << "\n";
+    cout << "kruskal            " << kruskal_time << " s\n";
+
+    double base = 0;
+    for (unsigned t = 1; t <= max_threads; t = (t * 2 > max_threads && t != max_threads) ? max_threads : t * 2) {
+        BoruvkaStats stats;
+        start = Clock::now();
+        vector<uint32_t> tree = boruvka_tree(edges, n, weight_of, t, &stats);
+        double time = seconds_since(start);
+        if (t == 1) base = time;
+
+        cout << "boruvka " << t << " threads: " << time << " s, speedup " << base / time << "x, "
+             << stats.rounds << " rounds" << (tree == reference ? "" : "  [TREE DIFFERS FROM KRUSKAL]") << "\n";
+    }
+
+    return 0;
+}
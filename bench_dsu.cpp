@@ -0,0 +1,107 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "dsu.h"
+
+using namespace std;
+
+// Micro-benchmark for dsu.h
+// Usage: bench_dsu [n]   (default n = 10^7)
+//
+// chain : unite(i, i+1) for every i, then find every node
+// star  : unite(0, i) for every i, then find every node
+// random: n random unites, then n random finds
+//
+// RollbackDSU   : the random unites, then one rollback to the start
+// PersistentDSU : the random unites, then n finds at random past versions
+
+using Clock = chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename D, typename Index>
+void run_workload(const string& name, Index n, const vector<pair<Index, Index>>& ops, const vector<Index>& finds) {
+    D dsu(n);
+
+    auto start = Clock::now();
+    for (const auto& op : ops) dsu.unite(op.first, op.second);
+    double unite_time = seconds_since(start);
+
+    start = Clock::now();
+    long long checksum = 0;
+    for (Index x : finds) checksum += dsu.find(x);
+    double find_time = seconds_since(start);
+
+    cout << "  " << name << ": unite " << (ops.size() / unite_time / 1e6) << " M/s, find "
+         << (finds.size() / find_time / 1e6) << " M/s (checksum " << checksum << ")\n";
+}
+
+template <typename Index>
+void run_versioned(Index n, const vector<pair<Index, Index>>& ops, const vector<Index>& finds) {
+    RollbackDSU rollback(n);
+    auto start = Clock::now();
+    for (const auto& op : ops) rollback.unite(op.first, op.second);
+    double unite_time = seconds_since(start);
+    size_t undone = rollback.checkpoint();
+    start = Clock::now();
+    rollback.rollback(0);
+    double rollback_time = seconds_since(start);
+    cout << "  rollback  : unite " << (ops.size() / unite_time / 1e6) << " M/s, undo " << (undone / rollback_time / 1e6)
+         << " M/s (" << undone << " unions)\n";
+
+    PersistentDSU persistent(n);
+    start = Clock::now();
+    for (const auto& op : ops) persistent.unite(op.first, op.second);
+    unite_time = seconds_since(start);
+    mt19937 rng(54321);
+    uniform_int_distribution<uint32_t> pick_version(0, persistent.version());
+    vector<uint32_t> versions(finds.size());
+    for (auto& v : versions) v = pick_version(rng);
+    start = Clock::now();
+    long long checksum = 0;
+    for (size_t i = 0; i < finds.size(); i++) checksum += persistent.find(finds[i], versions[i]);
+    double find_time = seconds_since(start);
+    cout << "  persistent: unite " << (ops.size() / unite_time / 1e6) << " M/s, find at version "
+         << (finds.size() / find_time / 1e6) << " M/s (checksum " << checksum << ")\n";
+}
+
+template <typename Index>
+void run_all(const string& label, Index n) {
+    cout << label << " n = " << n << "\n";
+
+    vector<Index> all_nodes(n);
+    for (Index i = 0; i < n; i++) all_nodes[i] = i;
+
+    vector<pair<Index, Index>> ops;
+    ops.reserve(n);
+
+    for (Index i = 0; i + 1 < n; i++) ops.push_back({i, i + 1});
+    run_workload<BasicDSU<Index>, Index>("chain ", n, ops, all_nodes);
+
+    ops.clear();
+    for (Index i = 1; i < n; i++) ops.push_back({0, i});
+    run_workload<BasicDSU<Index>, Index>("star  ", n, ops, all_nodes);
+
+    mt19937_64 rng(12345);
+    uniform_int_distribution<long long> pick(0, n - 1);
+    ops.clear();
+    for (Index i = 0; i < n; i++) ops.push_back({(Index)pick(rng), (Index)pick(rng)});
+    vector<Index> random_finds(n);
+    for (auto& x : random_finds) x = (Index)pick(rng);
+    run_workload<BasicDSU<Index>, Index>("random", n, ops, random_finds);
+    if constexpr (sizeof(Index) == 4) run_versioned<Index>(n, ops, random_finds);
+}
+
+int main(int argc, char** argv) {
+    long long n = argc > 1 ? stoll(argv[1]) : 10000000;
+
+    run_all<int32_t>("DSU   (32-bit)", (int32_t)n);
+    run_all<int64_t>("DSU64 (64-bit)", (int64_t)n);
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "cli.h"
+#include "latency.h"
+#include "unix_socket.h"
+
+using namespace std;
+
+// Load generator for pathmax_server --socket=path
+// Usage: bench_pathmax_server --socket=path --nodes=N [--clients=C]
+//                             [--requests=R] [--depth=D] [--max-weight=W]
+//   (defaults: 4 clients, 10^5 requests each, 16 in flight per client,
+//    weights up to 10^9)
+//
+// Every client opens its own connection and keeps D random requests in
+// flight (half "M u v", half "C u v w", u and v in 1..N): it sends D, waits
+// for their D replies, and repeats. A request's latency is from the send of
+// its group to the arrival of its reply line. Prints throughput and the
+// latency percentiles over all clients.
+
+using Clock = chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// One client; returns false if the connection failed
+bool run_client(const char* path, int nodes, long long requests, int depth, int max_weight, unsigned seed,
+                LatencyHistogram& hist, long long& errors) {
+    int fd = connect_unix(path);
+    if (fd < 0) return false;
+    mt19937 rng(seed);
+    uniform_int_distribution<int> node(1, nodes), weight(0, max_weight);
+
+    string out;
+    vector<char> in(1 << 16);
+    string line;
+    for (long long sent = 0; sent < requests;) {
+        int group = static_cast<int>(min<long long>(depth, requests - sent));
+        out.clear();
+        for (int k = 0; k < group; k++) {
+            if (rng() & 1) out += "M " + to_string(node(rng)) + " " + to_string(node(rng)) + "\n";
+            else out += "C " + to_string(node(rng)) + " " + to_string(node(rng)) + " " + to_string(weight(rng)) + "\n";
+        }
+        Clock::time_point start = Clock::now();
+        if (!write_all(fd, out.data(), out.size())) break;
+        sent += group;
+
+        for (int answered = 0; answered < group;) {
+            ssize_t got = ::read(fd, in.data(), in.size());
+            if (got <= 0) {
+                ::close(fd);
+                return false;
+            }
+            for (ssize_t i = 0; i < got; i++) {
+                if (in[i] != '\n') {
+                    line += in[i];
+                    continue;
+                }
+                hist.add(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count());
+                if (line == "error") errors++;
+                line.clear();
+                answered++;
+            }
+        }
+    }
+    ::close(fd);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* path = flag_value(argc, argv, "--socket");
+    int nodes = atoi(flag_value(argc, argv, "--nodes", "0"));
+    if (!path || nodes < 1) {
+        cerr << "usage: bench_pathmax_server --socket=path --nodes=N [--clients=C] [--requests=R] [--depth=D]\n";
+        return 1;
+    }
+    int clients = atoi(flag_value(argc, argv, "--clients", "4"));
+    long long requests = atoll(flag_value(argc, argv, "--requests", "100000"));
+    int depth = max(1, atoi(flag_value(argc, argv, "--depth", "16")));
+    int max_weight = atoi(flag_value(argc, argv, "--max-weight", "1000000000"));
+
+    vector<LatencyHistogram> hist(clients);
+    vector<long long> errors(clients, 0);
+    vector<char> ok(clients, 0);
+    auto start = Clock::now();
+    vector<thread> threads;
+    for (int c = 0; c < clients; c++) {
+        threads.emplace_back([&, c] { ok[c] = run_client(path, nodes, requests, depth, max_weight, 12345 + c, hist[c], errors[c]); });
+    }
+    for (auto& t : threads) t.join();
+    double elapsed = seconds_since(start);
+
+    LatencyHistogram all;
+    long long error_count = 0;
+    for (int c = 0; c < clients; c++) {
+        all.merge(hist[c]);
+        error_count += errors[c];
+        if (!ok[c]) cerr << "client " << c << " lost its connection\n";
+    }
+    cout << clients << " clients x " << requests << " requests, depth " << depth << ": " << (all.total / elapsed / 1e6)
+         << " M requests/s\n";
+    cout << "  " << all.summary() << "\n";
+    if (error_count) cout << "  " << error_count << " error replies\n";
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "radix_sort.h"
+
+using namespace std;
+
+// Benchmark: radix_sort_edges vs the comparator std::sort used before it
+// Usage: bench_radix_sort [threads] [m...]   (default: all cores, m = 10^6 10^7 10^8)
+
+struct Edge {
+    int u, v, w;
+    int id;
+};
+
+bool compareEdges(const Edge& a, const Edge& b) {
+    return a.w < b.w;
+}
+
+using Clock = chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = argc > 1 ? stoul(argv[1]) : 0;
+    vector<long long> sizes;
+    for (int i = 2; i < argc; i++) sizes.push_back(stoll(argv[i]));
+    if (sizes.empty()) sizes = {1000000, 10000000, 100000000};
+
+    mt19937 rng(12345);
+    for (long long m : sizes) {
+        vector<Edge> edges(m);
+        uniform_int_distribution<int> node(1, 1000000), weight(0, 1000000000);
+        for (int i = 0; i < m; i++) edges[i] = {node(rng), node(rng), weight(rng), i};
+
+        vector<Edge> a = edges;
+        auto start = Clock::now();
+        sort(a.begin(), a.end(), compareEdges);
+        double std_time = seconds_since(start);
+
+        vector<Edge> b = edges;
+        start = Clock::now();
+        radix_sort_edges(b, [](const Edge& e) { return e.w; }, false, threads);
+        double radix_time = seconds_since(start);
+
+        // Sanity: sorted by weight, ties in input order
+        bool ok = true;
+        for (size_t i = 1; i < b.size() && ok; i++) {
+            if (b[i - 1].w > b[i].w || (b[i - 1].w == b[i].w && b[i - 1].id > b[i].id)) ok = false;
+        }
+
+        cout << "m = " << m << ": std::sort " << std_time << " s, radix " << radix_time
+             << " s, speedup " << std_time / radix_time << "x" << (ok ? "" : "  [NOT SORTED]") << "\n";
+    }
+
+    return 0;
+}
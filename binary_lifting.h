@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "csr.h"
+
+// Binary lifting over a forest, for maximum-weight-on-path queries.
+//
+// All levels live in one flat array of interleaved (ancestor, max weight)
+// entries, so a jump is one load instead of two pointer chases. Nodes are
+// renumbered in BFS order, which puts parents and children close together.
+// The number of levels comes from the tallest tree: a path of 10^6 nodes
+// needs 20, a shallow tree a handful. Construction is one BFS and one pass
+// over the table; there is no recursion, so path-shaped trees of any size
+// are fine.
+//
+// The layout is a template parameter: NodeMajor keeps each node's levels
+// together, LevelMajor keeps each level contiguous. NodeMajor is the
+// default: in bench_binlift.cpp it answers queries up to 1.4x faster on
+// shallow trees and matches LevelMajor on deep ones.
+//
+// Usage:
+//   BinaryLifting<int> lift;
+//   lift.build(n, tree_adj);                     // CSRGraph<int> over nodes 0..n, arc data = weight
+//   if (lift.connected(u, v)) w = lift.path_max(u, v);
+
+enum class LiftLayout { LevelMajor, NodeMajor };
+
+template <typename W, LiftLayout Layout = LiftLayout::NodeMajor>
+struct BinaryLifting {
+    struct Entry {
+        int32_t up; // 2^k-th ancestor (a root is its own)
+        W max;      // Heaviest edge on the way there
+    };
+
+    static constexpr W NONE = std::numeric_limits<W>::lowest(); // Max of an empty path
+
+    int n = 0;
+    int levels = 0;
+    // Queries only read through these; they point into the vectors below
+    // after build(), or into a mapped snapshot after attach() (index_file.h)
+    const int32_t* index_of = nullptr; // Node -> BFS number (1..n)
+    const int32_t* depth = nullptr;    // By BFS number
+    const int32_t* root = nullptr;     // By BFS number: BFS number of its tree's root
+    const Entry* table = nullptr;      // levels * (n + 1) entries, see slot()
+
+    std::vector<int32_t> index_of_store, depth_store, root_store;
+    std::vector<Entry> table_store;
+
+    std::size_t slot(int k, int32_t x) const {
+        if (Layout == LiftLayout::LevelMajor) return static_cast<std::size_t>(k) * (n + 1) + x;
+        return static_cast<std::size_t>(x) * levels + k;
+    }
+
+    const Entry& at(int k, int32_t x) const { return table[slot(k, x)]; }
+
+    std::size_t table_size() const { return static_cast<std::size_t>(levels) * (n + 1); }
+
+    // Use tables built elsewhere (same layout); nothing is copied
+    void attach(int num_nodes, int num_levels, const int32_t* index_of_data, const int32_t* depth_data,
+                const int32_t* root_data, const Entry* table_data) {
+        n = num_nodes;
+        levels = num_levels;
+        index_of = index_of_data;
+        depth = depth_data;
+        root = root_data;
+        table = table_data;
+    }
+
+    // tree: the forest over nodes 1..n (node 0 unused)
+    template <typename Data>
+    void build(int num_nodes, const CSRGraph<Data>& tree) {
+        n = num_nodes;
+        std::vector<int32_t>& index_of = index_of_store;
+        std::vector<int32_t>& depth = depth_store;
+        std::vector<int32_t>& root = root_store;
+        std::vector<Entry>& table = table_store;
+        index_of.assign(n + 1, 0);
+        depth.assign(n + 1, 0);
+        root.assign(n + 1, 0);
+        std::vector<int32_t> up(n + 1, 0);
+        std::vector<W> weight(n + 1, NONE);
+
+        // 1. BFS every tree; BFS numbers are positions in order
+        std::vector<int32_t> order(1, 0);
+        order.reserve(n + 1);
+        int max_depth = 0;
+        for (int s = 1; s <= n; s++) {
+            if (index_of[s]) continue;
+            int32_t r = static_cast<int32_t>(order.size());
+            index_of[s] = r;
+            order.push_back(s);
+            up[r] = r;
+            root[r] = r;
+            for (std::size_t head = r; head < order.size(); head++) {
+                int32_t x = static_cast<int32_t>(head);
+                for (uint32_t a = tree.begin(order[x]); a < tree.end(order[x]); a++) {
+                    int y = tree.target[a];
+                    if (index_of[y]) continue;
+                    int32_t id = static_cast<int32_t>(order.size());
+                    index_of[y] = id;
+                    order.push_back(y);
+                    depth[id] = depth[x] + 1;
+                    up[id] = x;
+                    weight[id] = tree.data[a];
+                    root[id] = r;
+                    if (depth[id] > max_depth) max_depth = depth[id];
+                }
+            }
+        }
+
+        // 2. Levels 0 .. levels - 1, each from the one below
+        levels = 1;
+        while ((1 << levels) <= max_depth) levels++;
+        table.assign(table_size(), Entry{0, NONE});
+        for (int32_t x = 1; x <= n; x++) table[slot(0, x)] = {up[x], weight[x]};
+        auto fill = [&](int k, int32_t x) {
+            const Entry& a = table[slot(k - 1, x)];
+            const Entry& b = table[slot(k - 1, a.up)];
+            table[slot(k, x)] = {b.up, a.max < b.max ? b.max : a.max};
+        };
+        if (Layout == LiftLayout::LevelMajor) {
+            for (int k = 1; k < levels; k++) {
+                for (int32_t x = 1; x <= n; x++) fill(k, x);
+            }
+        } else {
+            // Ancestors come first in BFS order, so one row at a time works
+            for (int32_t x = 1; x <= n; x++) {
+                for (int k = 1; k < levels; k++) fill(k, x);
+            }
+        }
+        attach(n, levels, index_of.data(), depth.data(), root.data(), table.data());
+    }
+
+    bool connected(int u, int v) const { return root[index_of[u]] == root[index_of[v]]; }
+
+    // Heaviest edge on the path between connected nodes u and v (NONE if u == v)
+    W path_max(int u, int v) const {
+        int32_t a = index_of[u], b = index_of[v];
+        W res = NONE;
+        auto take = [&res](const Entry& e) {
+            if (res < e.max) res = e.max;
+        };
+        if (depth[a] < depth[b]) std::swap(a, b);
+
+        // 1. Lift a to the depth of b
+        int k = 0;
+        for (unsigned diff = depth[a] - depth[b]; diff; diff >>= 1, k++) {
+            if (diff & 1) {
+                take(at(k, a));
+                a = at(k, a).up;
+            }
+        }
+        if (a == b) return res;
+
+        // 2. Lift both until they are just below the LCA
+        for (k = levels - 1; k >= 0; k--) {
+            const Entry& ea = at(k, a);
+            const Entry& eb = at(k, b);
+            if (ea.up != eb.up) {
+                take(ea);
+                take(eb);
+                a = ea.up;
+                b = eb.up;
+            }
+        }
+
+        // 3. The last edge on each side
+        take(at(0, a));
+        take(at(0, b));
+        return res;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "concurrent_dsu.h"
+#include "parallel.h"
+#include "radix_sort.h"
+
+// Multi-core Borůvka MST engine.
+//
+// Each round every component picks its minimum outgoing edge in parallel
+// (an atomic min per component root), the picked edges are contracted with a
+// lock-free union-find, and edges that ended up inside one component are
+// compacted away. Edges are compared by (weight, input position), a strict
+// total order, so the picked edges always form a forest and the result is
+// exactly the tree Kruskal finds with ties broken by input position.
+//
+// Like the engines in mst.h, the edge list is never reordered and the tree is
+// returned as input positions in Kruskal order.
+
+struct BoruvkaStats {
+    std::size_t rounds = 0;
+    std::size_t dropped = 0;   // Edges removed because both ends were already merged
+    std::size_t remaining = 0; // Edges still live when the forest became spanning
+};
+
+const uint32_t BORUVKA_NO_EDGE = UINT32_MAX;
+
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> boruvka_tree(const Edges& edges, int n, WeightOf weight_of, unsigned num_threads = 0,
+                                   BoruvkaStats* stats = nullptr) {
+    const std::size_t m = edges.size();
+    const std::size_t nodes = static_cast<std::size_t>(n) + 1;
+    const std::size_t target = n > 0 ? n - 1 : 0;
+    const unsigned threads = resolve_thread_count(std::max(m, nodes), num_threads, 1 << 14);
+
+    auto less = [&](uint32_t a, uint32_t b) {
+        auto wa = weight_of(edges[a]);
+        auto wb = weight_of(edges[b]);
+        return wa < wb || (!(wb < wa) && a < b);
+    };
+
+    // Atomic min on (weight, position)
+    auto offer = [&](std::atomic<uint32_t>& slot, uint32_t pos) {
+        uint32_t cur = slot.load(std::memory_order_relaxed);
+        while (cur == BORUVKA_NO_EDGE || less(pos, cur)) {
+            if (slot.compare_exchange_weak(cur, pos, std::memory_order_relaxed)) return;
+        }
+    };
+
+    ConcurrentDSU dsu(n);
+    std::vector<std::atomic<uint32_t>> best(nodes);
+    std::vector<uint32_t> live(m), next;
+    parallel_for(m, threads, [&](std::size_t i) { live[i] = static_cast<uint32_t>(i); });
+
+    std::vector<uint32_t> tree(target);
+    std::atomic<std::size_t> tree_size{0};
+    std::vector<std::size_t> kept(threads + 1);
+    BoruvkaStats local;
+
+    while (!live.empty() && tree_size.load() < target) {
+        local.rounds++;
+        parallel_for(nodes, threads, [&](std::size_t i) { best[i].store(BORUVKA_NO_EDGE, std::memory_order_relaxed); });
+
+        // 1. Minimum outgoing edge of every component
+        parallel_for(live.size(), threads, [&](std::size_t i) {
+            uint32_t pos = live[i];
+            uint32_t ru = dsu.find(edges[pos].u);
+            uint32_t rv = dsu.find(edges[pos].v);
+            if (ru == rv) return;
+            offer(best[ru], pos);
+            offer(best[rv], pos);
+        });
+
+        // 2. Contract. When two components pick the same edge only one unite() succeeds
+        parallel_for(nodes, threads, [&](std::size_t r) {
+            uint32_t pos = best[r].load(std::memory_order_relaxed);
+            if (pos == BORUVKA_NO_EDGE) return;
+            if (dsu.unite(edges[pos].u, edges[pos].v)) tree[tree_size.fetch_add(1)] = pos;
+        });
+
+        // 3. Compact the live edges, dropping those now inside one component
+        const std::size_t count = live.size();
+        const unsigned chunks = resolve_thread_count(count, threads, 1 << 14);
+        parallel_chunks(count, chunks, [&](unsigned t, std::size_t begin, std::size_t end) {
+            std::size_t k = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                if (!dsu.same(edges[live[i]].u, edges[live[i]].v)) k++;
+            }
+            kept[t + 1] = k;
+        });
+        kept[0] = 0;
+        for (unsigned t = 0; t < chunks; t++) kept[t + 1] += kept[t];
+        next.resize(kept[chunks]);
+        parallel_chunks(count, chunks, [&](unsigned t, std::size_t begin, std::size_t end) {
+            std::size_t out = kept[t];
+            for (std::size_t i = begin; i < end; i++) {
+                if (!dsu.same(edges[live[i]].u, edges[live[i]].v)) next[out++] = live[i];
+            }
+        });
+        local.dropped += count - next.size();
+        live.swap(next);
+    }
+    local.remaining = live.size();
+    if (stats) *stats = local;
+
+    // Put the tree in Kruskal order: by weight, ties by input position
+    tree.resize(tree_size.load());
+    std::sort(tree.begin(), tree.end());
+    std::vector<uint32_t> order = radix_sort_order(tree, [&](uint32_t pos) { return weight_of(edges[pos]); }, false, threads);
+    std::vector<uint32_t> result(tree.size());
+    for (std::size_t i = 0; i < result.size(); i++) result[i] = tree[order[i]];
+    return result;
+}
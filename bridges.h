@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "csr.h"
+
+// Bridges of an undirected multigraph (Tarjan's low-link), with an explicit
+// stack instead of recursion, so a path of millions of nodes is fine.
+//
+// The graph is a CSRGraph whose arc data identifies the edge: both arcs of an
+// edge carry the same value, and no two edges share one. The DFS leaves a node
+// through every arc except the one it came in by, so parallel edges are never
+// bridges. The buffers are kept between calls; one BridgeFinder per thread.
+//
+// Usage:
+//   BridgeFinder bridges;
+//   bridges.run(g, [&](int id) { critical[id] = 1; });
+
+struct BridgeFinder {
+    static const uint32_t NONE = UINT32_MAX;
+
+    std::vector<int32_t> tin, low;
+    std::vector<uint32_t> cursor;   // Next arc to look at, per node
+    std::vector<uint32_t> via;      // Arc the DFS entered the node by
+    std::vector<int32_t> stack;
+
+    // Calls on_bridge(data) once for every bridge, in no particular order
+    template <typename Data, typename OnBridge>
+    void run(const CSRGraph<Data>& g, OnBridge on_bridge) {
+        int n = g.nodes();
+        tin.assign(n, -1);
+        low.resize(n);
+        cursor.resize(n);
+        via.resize(n);
+        int32_t timer = 0;
+
+        auto enter = [&](int x, uint32_t arc) {
+            tin[x] = low[x] = timer++;
+            cursor[x] = g.begin(x);
+            via[x] = arc;
+            stack.push_back(x);
+        };
+
+        for (int s = 0; s < n; s++) {
+            if (tin[s] != -1) continue;
+            enter(s, NONE);
+            while (!stack.empty()) {
+                int u = stack.back();
+                if (cursor[u] < g.end(u)) {
+                    uint32_t a = cursor[u]++;
+                    if (via[u] != NONE && g.data[a] == g.data[via[u]]) continue; // The edge we came by
+                    int v = g.target[a];
+                    if (tin[v] != -1) low[u] = std::min(low[u], tin[v]);
+                    else enter(v, a);
+                    continue;
+                }
+                // u is done: hand its low-link to the parent
+                stack.pop_back();
+                if (stack.empty()) break;
+                int p = stack.back();
+                low[p] = std::min(low[p], low[u]);
+                if (low[u] > tin[p]) on_bridge(g.data[via[u]]);
+            }
+        }
+    }
+};
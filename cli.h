@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+// Tiny command-line helpers shared by the programs.
+// Flags look like "--stats" or "--engine=filter".
+
+inline bool has_flag(int argc, char** argv, const char* flag) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], flag) == 0) return true;
+    }
+    return false;
+}
+
+// Value of "--name=value", or fallback if the option is absent
+inline const char* flag_value(int argc, char** argv, const char* name, const char* fallback = nullptr) {
+    std::size_t len = std::strlen(name);
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], name, len) == 0 && argv[i][len] == '=') return argv[i] + len + 1;
+    }
+    return fallback;
+}
+
+// Strict decimal int: the whole string must be the number and fit in an int
+inline bool parse_int(const char* s, int& out) {
+    if (s == nullptr || *s == '\0') return false;
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(s, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value < INT_MIN || value > INT_MAX) return false;
+    out = static_cast<int>(value);
+    return true;
+}
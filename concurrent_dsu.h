@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Lock-free union-find for multi-threaded engines.
+//
+// Every parent pointer is an atomic; roots point at themselves. Links always
+// hang the larger root index under the smaller one with a CAS, so concurrent
+// unite() calls can never form a cycle. find() does path halving with relaxed
+// CAS writes: a lost race only means a pointer was not shortened this time.
+//
+// Like DSU, ConcurrentDSU(n) is sized for nodes 0..n-1 or 1..n.
+struct ConcurrentDSU {
+    std::vector<std::atomic<uint32_t>> parent;
+
+    explicit ConcurrentDSU(std::size_t n) : parent(n + 1) {
+        for (std::size_t i = 0; i <= n; i++) parent[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            uint32_t g = parent[p].load(std::memory_order_relaxed);
+            if (g != p) parent[x].compare_exchange_weak(p, g, std::memory_order_relaxed);
+            x = g;
+        }
+    }
+
+    // Returns true for exactly one of any set of racing calls that merge the same two sets
+    bool unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            uint32_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return true;
+        }
+    }
+
+    bool same(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return true;
+            // a is still a root, so the two sets really were distinct at this instant
+            if (parent[a].load(std::memory_order_acquire) == a) return false;
+        }
+    }
+};
@@ -4,6 +4,15 @@
 #include <numeric>
 #include <map>
 
+#include "bridges.h"
+#include "csr.h"
+#include "dedup.h"
+#include "dsu.h"
+#include "edge_input.h"
+#include "fast_output.h"
+#include "parallel.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 struct Edge {
@@ -11,142 +20,128 @@ struct Edge {
     int id;
 };
 
-bool compareEdges(const Edge& a, const Edge& b) {
-    return a.w < b.w;
-}
+// Per-edge classification, one byte per edge; names in the same order
+enum EdgeClass : uint8_t { NONE, PSEUDO_CRITICAL, CRITICAL };
+const ResultTable CLASS_NAMES = {"None", "Pseudo-Critical", "Critical"};
+vector<uint8_t> results;
 
-// Disjoint Set Union (DSU)
-struct DSU {
-    vector<int> parent;
-    DSU(int n) {
-        parent.resize(n + 1);
-        iota(parent.begin(), parent.end(), 0);
-    }
-    int find(int i) {
-        if (parent[i] == i) return i;
-        return parent[i] = find(parent[i]);
-    }
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) parent[root_i] = root_j;
-    }
+// Edges of one weight that join different components of the lighter edges:
+// batch_edges[begin, end) of the component graph on nodes 0..nodes-1
+struct Batch {
+    uint32_t begin, end;
+    int nodes;
 };
 
-// Global variables for Tarjan's Bridge Finding
-vector<int> tin, low;
-int timer;
-vector<vector<pair<int, int>>> adj; // adj[u] = {v, edge_index}
-vector<string> results;
-
-void dfs_bridges(int u, int p = -1, int edge_id = -1) {
-    tin[u] = low[u] = ++timer;
-    
-    for (auto& edge : adj[u]) {
-        int v = edge.first;
-        int id = edge.second;
-        
-        if (id == edge_id) continue; // Don't go back through the same edge
-        
-        if (tin[v] != -1) {
-            // Back-edge
-            low[u] = min(low[u], tin[v]);
-        } else {
-            // Tree-edge
-            dfs_bridges(v, u, id);
-            low[u] = min(low[u], low[v]);
-            
-            // Bridge check
-            if (low[v] > tin[u]) {
-                results[id] = "Critical";
-            }
-        }
-    }
-}
-
-int main() {
+int main(int argc, char** argv) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n, m;
-    if (!(cin >> n >> m)) return 0;
-
-    vector<Edge> edges(m);
-    for (int i = 0; i < m; ++i) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
-        edges[i].id = i;
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    int n;
+    vector<Edge> edges;
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, n, edges)) return 0;
+    int m = edges.size();
+    for (int i = 0; i < m; ++i) edges[i].id = i;
+
+    // --dedup: classify one copy per pair, the others are resolved at the end
+    // (--stats prints the reduction)
+    DedupResult dedup;
+    bool dedup_on = has_flag(argc, argv, "--dedup");
+    if (dedup_on) {
+        dedup = dedup_edges(edges, [](const Edge& e) { return e.w; });
+        if (has_flag(argc, argv, "--stats")) print_dedup_stats(dedup.stats);
+        keep_edges(edges, dedup.kept);
     }
+    int count = edges.size();
 
-    sort(edges.begin(), edges.end(), compareEdges);
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; });
 
     DSU dsu(n);
-    results.resize(m, "None"); // Default to None
-
-    // Buffers for bridge finding
-    // We map component IDs to small integers 0..k for the temp graph
-    tin.resize(n + 1);
-    low.resize(n + 1);
-    adj.resize(n + 1);
+    results.assign(m, NONE); // Default to None
+
+    // Phase 1, sequential: one Kruskal pass over the weight groups. An edge
+    // whose ends are already connected through lighter edges is in no MST;
+    // the others are in some MST, and critical iff they are a bridge of the
+    // group's component graph (nodes = DSU roots before the group is merged).
+    // Only those component graphs are recorded, on small local node numbers.
+    vector<int> local_id(n + 1, -1);   // DSU root -> node of the current batch
+    vector<int> batch_roots;           // Node of the current batch -> DSU root
+    vector<CSREdge<int>> batch_edges;  // All batches' edges {node, node, edge_index}
+    vector<Batch> batches;
+    auto local = [&](int root) {
+        if (local_id[root] == -1) {
+            local_id[root] = batch_roots.size();
+            batch_roots.push_back(root);
+        }
+        return local_id[root];
+    };
 
     int i = 0;
-    while (i < m) {
+    while (i < count) {
         int j = i;
-        while (j < m && edges[j].w == edges[i].w) j++;
+        while (j < count && edges[j].w == edges[i].w) j++;
 
-        // 1. Identify valid edges (Can be in MST)
-        // Add them to a temporary graph to find bridges
-        vector<int> nodes_in_batch;
-        
+        uint32_t begin = batch_edges.size();
         for (int k = i; k < j; ++k) {
             int root_u = dsu.find(edges[k].u);
             int root_v = dsu.find(edges[k].v);
-
             if (root_u != root_v) {
-                // This edge connects two previously unconnected components
-                results[edges[k].id] = "Pseudo-Critical"; // Tentative assignment
-                
-                // Build adjacency list for temp graph
-                adj[root_u].push_back({root_v, edges[k].id});
-                adj[root_v].push_back({root_u, edges[k].id});
-                
-                nodes_in_batch.push_back(root_u);
-                nodes_in_batch.push_back(root_v);
-            } else {
-                // Loops within the same component -> Never in MST
-                results[edges[k].id] = "None";
-            }
-        }
-
-        // 2. Find Critical edges (Bridges in the temp graph)
-        timer = 0;
-        // Reset tin/low for involved nodes only
-        for (int node : nodes_in_batch) {
-            tin[node] = -1;
-            low[node] = -1;
-        }
-
-        for (int node : nodes_in_batch) {
-            if (tin[node] == -1) {
-                dfs_bridges(node);
+                results[edges[k].id] = PSEUDO_CRITICAL; // Until it turns out to be a bridge
+                batch_edges.push_back({local(root_u), local(root_v), edges[k].id});
             }
         }
-
-        // 3. Clean up and Union
-        for (int node : nodes_in_batch) {
-            adj[node].clear(); // Clear adjacency list for next batch
+        uint32_t size = batch_edges.size() - begin;
+        if (size == 1) {
+            // Alone, the edge is a bridge: no need to search
+            results[batch_edges.back().data] = CRITICAL;
+            batch_edges.pop_back();
+        } else if (size > 1) {
+            batches.push_back({begin, begin + size, static_cast<int>(batch_roots.size())});
         }
+        for (int root : batch_roots) local_id[root] = -1;
+        batch_roots.clear();
 
         for (int k = i; k < j; ++k) {
             dsu.unite(edges[k].u, edges[k].v);
         }
-
         i = j;
     }
 
-    // Output results
-    for (int k = 0; k < m; ++k) {
-        cout << results[k] << "\n";
+    // Phase 2, parallel (--threads=N, default: all cores): the bridges of
+    // every batch, independently. Batch sizes vary wildly, so the largest go
+    // first and idle threads steal the rest (parallel_for_stealing).
+    sort(batches.begin(), batches.end(), [](const Batch& a, const Batch& b) {
+        return a.end - a.begin > b.end - b.begin;
+    });
+    unsigned threads = resolve_thread_count(batch_edges.size(), atoi(flag_value(argc, argv, "--threads", "0")), 1 << 14);
+    vector<CSRGraph<int>> adj(threads);      // Component graph of the batch, arc data = edge index
+    vector<BridgeFinder> bridges(threads);
+    parallel_for_stealing(batches.size(), threads, [&](unsigned t, size_t b) {
+        const Batch& batch = batches[b];
+        adj[t].build(batch.nodes, batch.end - batch.begin, [&](size_t k) { return batch_edges[batch.begin + k]; });
+        bridges[t].run(adj[t], [&](int id) { results[id] = CRITICAL; });
+    });
+
+    // Dropped copies. Heavier copies and self-loops are in no MST. Copies as
+    // light as the kept edge are interchangeable with it: none of them is
+    // critical, and each is pseudo-critical iff the kept edge is in some MST.
+    if (dedup_on) {
+        for (int e = 0; e < m; ++e) {
+            uint32_t r = dedup.rep[e];
+            if (r == (uint32_t)e) continue;
+            if (r < DEDUP_DOMINATED && results[r] != NONE) {
+                results[r] = PSEUDO_CRITICAL;
+                results[e] = PSEUDO_CRITICAL;
+            } else {
+                results[e] = NONE;
+            }
+        }
     }
 
+    // Output results (--binary-output writes the raw class bytes instead)
+    FastOutput out;
+    write_results(out, results, CLASS_NAMES, has_flag(argc, argv, "--binary-output"));
+
     return 0;
 }
\ No newline at end of file
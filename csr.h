@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Compressed sparse row adjacency for the trees and graphs the programs walk
+// (MST paths, cut components, bridge finding).
+//
+// All arcs live in two flat arrays, grouped by source node: the arcs of node x
+// are target[a], data[a] for a in [begin(x), end(x)). data is whatever the
+// walk needs per arc (an edge weight, an edge id). build() makes an undirected
+// graph from an edge subset in two linear passes (degree count, then fill) and
+// keeps arc order equal to edge order, so walks visit neighbours in the same
+// order as the push_back adjacency lists they replace. Rebuilding reuses the
+// arrays, so only growth past the previous size allocates.
+//
+// Usage:
+//   CSRGraph<int> g;
+//   g.build(n + 1, tree.size(), [&](size_t k) { return CSREdge<int>{u[k], v[k], w[k]}; });
+//   for (uint32_t a = g.begin(x); a < g.end(x); a++) visit(g.target[a], g.data[a]);
+
+template <typename Data>
+struct CSREdge {
+    int32_t u, v;
+    Data data;
+};
+
+template <typename Data>
+struct CSRGraph {
+    std::vector<uint32_t> offset; // Size nodes + 1
+    std::vector<int32_t> target;
+    std::vector<Data> data;
+
+    int nodes() const { return offset.empty() ? 0 : static_cast<int>(offset.size()) - 1; }
+    uint32_t begin(int x) const { return offset[x]; }
+    uint32_t end(int x) const { return offset[x + 1]; }
+    uint32_t degree(int x) const { return offset[x + 1] - offset[x]; }
+
+    // Undirected graph on nodes 0..n-1 from count edges; edge_at(k) returns a
+    // CSREdge and each edge becomes two arcs (u -> v and v -> u)
+    template <typename EdgeAt>
+    void build(int n, std::size_t count, EdgeAt edge_at) {
+        offset.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (std::size_t k = 0; k < count; k++) {
+            CSREdge<Data> e = edge_at(k);
+            offset[e.u + 1]++;
+            offset[e.v + 1]++;
+        }
+        for (int x = 0; x < n; x++) offset[x + 1] += offset[x];
+
+        target.resize(2 * count);
+        data.resize(2 * count);
+        // offset[x] is used as the fill cursor of x, then shifted back
+        for (std::size_t k = 0; k < count; k++) {
+            CSREdge<Data> e = edge_at(k);
+            uint32_t a = offset[e.u]++;
+            target[a] = e.v;
+            data[a] = e.data;
+            uint32_t b = offset[e.v]++;
+            target[b] = e.u;
+            data[b] = e.data;
+        }
+        for (int x = n; x > 0; x--) offset[x] = offset[x - 1];
+        offset[0] = 0;
+    }
+};
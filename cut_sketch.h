@@ -0,0 +1,374 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Euler tour forest with XOR cut sketches, for finding edges that cross the
+// cut left by removing a tree edge.
+//
+// Every non-tree edge end is an entry (slot, tag) at its vertex, where the
+// slot is a group the caller picks (dynamic_mst.h uses weight buckets) and
+// the tag is a 64-bit value shared by both ends of the edge. XORing the tags
+// of every entry in one tree cancels each edge with both ends inside it,
+// leaving per slot the XOR of the edges that leave it: non-zero means some
+// edge of that slot crosses. A crossing edge is missed only if the tags of
+// the crossing edges XOR to 0, which for random tags has probability 2^-64
+// per slot. Tags must therefore be unpredictable to whoever writes the
+// input: a fixed function of the edge id lets anyone solve for a set of ids
+// that cancels. random_key() gives a per-run key to derive them from; the
+// treap priorities are seeded from it too.
+//
+// Each tree is its Euler tour (one node per vertex, two per tree edge) in a
+// treap with parent pointers, so link, cut and reroot are O(log n) splits
+// and merges, and connected() walks to the roots. A vertex's entries sit in
+// chunk nodes of CHUNK entries right after the vertex node. A treap node with
+// at least fat_size nodes below it keeps the per-slot XOR of its subtree;
+// smaller ones are summed on demand. tree_sketch(v) is then the root's array,
+// read in O(slots). With fat_size ~ sqrt(entries) and about as many slots,
+// the arrays take O(n + entries) memory and a split or merge O(sqrt(entries)
+// log n) time.
+//
+// Sketches can be switched off while a large initial forest is built and
+// computed in one pass by enable_sketches().
+//
+// Usage:
+//   CutSketchForest f(n, fat_size);           // Vertices 0..n, no edges
+//   f.link(id, u, v);  f.add_end(u, 2 * id, slot, tag);  f.cut(id);
+//   const std::vector<uint64_t>& leaving = f.tree_sketch(u);   // Per slot
+
+struct CutSketchForest {
+    static const uint32_t CHUNK = 8;
+
+    struct Node {
+        int32_t left = -1, right = -1, parent = -1;
+        uint32_t size = 1;
+        uint32_t prio = 0;
+        int32_t vertex = -1; // Vertex and chunk nodes: the vertex; arcs: -1
+        int32_t chunk = -1;  // Chunk node k holds entries [k * CHUNK, (k + 1) * CHUNK)
+        int32_t sketch = -1; // Fat node: its array in sketches
+    };
+
+    struct Entry {
+        uint32_t slot;
+        uint32_t end; // Caller's id of the edge end
+        uint64_t tag;
+    };
+
+    std::vector<Node> t;                     // Node v is vertex v
+    std::vector<int32_t> free_nodes;         // Arc nodes of cut edges
+    std::vector<int32_t> arc_of;             // 2 * edge (+1) -> arc node, -1 if not a tree edge
+    std::vector<std::vector<Entry>> entries; // Per vertex
+    std::vector<std::vector<int32_t>> chunks;
+    std::vector<uint32_t> where;             // End -> index in its vertex's entries
+
+    std::vector<std::vector<uint64_t>> sketches;
+    std::vector<int32_t> free_sketches;
+    std::vector<uint64_t> scratch;
+    uint32_t slot_count = 0;
+    uint32_t fat_size;
+    bool sketching = false;
+    uint32_t seed;
+
+    explicit CutSketchForest(int n = 0, uint32_t fat = 64)
+        : fat_size(fat < 2 ? 2 : fat), seed(static_cast<uint32_t>(random_key()) | 1) {
+        t.resize(n + 1);
+        for (Node& x : t) x.prio = next_prio();
+        entries.assign(n + 1, {});
+        chunks.assign(n + 1, {});
+    }
+
+    // 64 bits that differ from run to run
+    static uint64_t random_key() {
+        std::random_device device;
+        uint64_t key = (static_cast<uint64_t>(device()) << 32) ^ device();
+        return key ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    // Compute the arrays of all fat nodes; from now on every change keeps them
+    void enable_sketches() {
+        sketching = true;
+        std::vector<char> done(t.size(), 0);
+        for (std::size_t v = 0; v < entries.size(); v++) {
+            int r = root(static_cast<int>(v));
+            if (!done[r]) rebuild(r);
+            done[r] = 1;
+        }
+    }
+
+    // Slots 0..count-1 may be used from now on
+    void reserve_slots(uint32_t count) {
+        if (count <= slot_count) return;
+        uint32_t grown = slot_count ? slot_count : 16;
+        while (grown < count) grown *= 2;
+        slot_count = grown;
+        for (std::vector<uint64_t>& s : sketches) {
+            if (!s.empty()) s.resize(slot_count, 0);
+        }
+    }
+
+    bool connected(int u, int v) const { return root(u) == root(v); }
+
+    void link(uint32_t edge, int u, int v) {
+        if (arc_of.size() < 2 * edge + 2) arc_of.resize(2 * edge + 2, -1);
+        int a = new_arc(), b = new_arc();
+        arc_of[2 * edge] = a;
+        arc_of[2 * edge + 1] = b;
+        int tu = reroot(u), tv = reroot(v);
+        finish(merge(merge(merge(tu, a), tv), b));
+    }
+
+    void cut(uint32_t edge) {
+        int a = arc_of[2 * edge], b = arc_of[2 * edge + 1];
+        arc_of[2 * edge] = arc_of[2 * edge + 1] = -1;
+        int tree = root(a);
+        uint32_t ra = rank(a), rb = rank(b);
+        if (ra > rb) {
+            std::swap(a, b);
+            std::swap(ra, rb);
+        }
+        // tree = before, a, between, b, after: 'between' is one side
+        int left, rest, between, after, skip;
+        split(tree, rb, rest, after);
+        split(after, 1, skip, after);
+        split(rest, ra, left, between);
+        split(between, 1, skip, between);
+        finish(merge(left, after));
+        finish(between);
+        release_node(a);
+        release_node(b);
+    }
+
+    // Add the end of an edge at v to the sketches of slot
+    void add_end(int v, uint32_t end, uint32_t slot, uint64_t tag) {
+        std::size_t p = entries[v].size();
+        if (p / CHUNK == chunks[v].size()) new_chunk(v);
+        if (where.size() <= end) where.resize(end + 1);
+        where[end] = static_cast<uint32_t>(p);
+        entries[v].push_back({slot, end, tag});
+        toggle(chunk_of(v, p), slot, tag);
+    }
+
+    void remove_end(int v, uint32_t end) {
+        std::vector<Entry>& list = entries[v];
+        std::size_t p = where[end], last = list.size() - 1;
+        toggle(chunk_of(v, p), list[p].slot, list[p].tag);
+        if (p != last) {
+            Entry moved = list[last];
+            toggle(chunk_of(v, last), moved.slot, moved.tag);
+            list[p] = moved;
+            where[moved.end] = static_cast<uint32_t>(p);
+            toggle(chunk_of(v, p), moved.slot, moved.tag);
+        }
+        list.pop_back();
+    }
+
+    void set_slot(int v, uint32_t end, uint32_t slot) {
+        Entry& e = entries[v][where[end]];
+        int c = chunk_of(v, where[end]);
+        toggle(c, e.slot, e.tag);
+        e.slot = slot;
+        toggle(c, e.slot, e.tag);
+    }
+
+    // Per slot, the XOR of the tags of the edges leaving v's tree
+    const std::vector<uint64_t>& tree_sketch(int v) {
+        int r = root(v);
+        if (t[r].sketch >= 0) return sketches[t[r].sketch];
+        scratch.assign(slot_count, 0);
+        accumulate(r, scratch);
+        return scratch;
+    }
+
+private:
+    uint32_t next_prio() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    uint32_t size(int x) const { return x < 0 ? 0 : t[x].size; }
+
+    int root(int x) const {
+        while (t[x].parent >= 0) x = t[x].parent;
+        return x;
+    }
+
+    // Nodes before x in its tour
+    uint32_t rank(int x) const {
+        uint32_t r = size(t[x].left);
+        for (int p = t[x].parent; p >= 0; x = p, p = t[p].parent) {
+            if (t[p].right == x) r += size(t[p].left) + 1;
+        }
+        return r;
+    }
+
+    int chunk_of(int v, std::size_t p) const { return chunks[v][p / CHUNK]; }
+
+    int new_arc() {
+        int x;
+        if (free_nodes.empty()) {
+            x = static_cast<int>(t.size());
+            t.emplace_back();
+        } else {
+            x = free_nodes.back();
+            free_nodes.pop_back();
+        }
+        t[x] = Node();
+        t[x].prio = next_prio();
+        return x;
+    }
+
+    void release_node(int x) {
+        drop_sketch(x);
+        t[x] = Node();
+        free_nodes.push_back(x);
+    }
+
+    // A chunk node for v, placed right after v's vertex node
+    void new_chunk(int v) {
+        int x = static_cast<int>(t.size());
+        t.emplace_back();
+        t[x].prio = next_prio();
+        t[x].vertex = v;
+        t[x].chunk = static_cast<int32_t>(chunks[v].size());
+        chunks[v].push_back(x);
+        int tree = root(v), left, right;
+        split(tree, rank(v) + 1, left, right);
+        finish(merge(merge(left, x), right));
+    }
+
+    // Rotate v's tour to start at v; returns the root
+    int reroot(int v) {
+        int tree = root(v);
+        uint32_t k = rank(v);
+        if (k == 0) return tree;
+        int left, right;
+        split(tree, k, left, right);
+        return merge(right, left);
+    }
+
+    void finish(int x) {
+        if (x >= 0) t[x].parent = -1;
+    }
+
+    void set_left(int x, int c) {
+        t[x].left = c;
+        if (c >= 0) t[c].parent = x;
+    }
+
+    void set_right(int x, int c) {
+        t[x].right = c;
+        if (c >= 0) t[c].parent = x;
+    }
+
+    int merge(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (t[a].prio > t[b].prio) {
+            set_right(a, merge(t[a].right, b));
+            pull(a);
+            return a;
+        }
+        set_left(b, merge(a, t[b].left));
+        pull(b);
+        return b;
+    }
+
+    // First k nodes of x's tour into a, the rest into b (both new roots)
+    void split(int x, uint32_t k, int& a, int& b) {
+        if (x < 0) {
+            a = b = -1;
+            return;
+        }
+        if (size(t[x].left) < k) {
+            int r1, r2;
+            split(t[x].right, k - size(t[x].left) - 1, r1, r2);
+            set_right(x, r1);
+            pull(x);
+            a = x;
+            b = r2;
+        } else {
+            int l1, l2;
+            split(t[x].left, k, l1, l2);
+            set_left(x, l2);
+            pull(x);
+            a = l1;
+            b = x;
+        }
+        finish(a);
+        finish(b);
+    }
+
+    void pull(int x) {
+        Node& n = t[x];
+        n.size = 1 + size(n.left) + size(n.right);
+        if (!sketching) return;
+        if (n.size < fat_size) {
+            drop_sketch(x);
+            return;
+        }
+        if (n.sketch < 0) {
+            if (free_sketches.empty()) {
+                n.sketch = static_cast<int32_t>(sketches.size());
+                sketches.emplace_back();
+            } else {
+                n.sketch = free_sketches.back();
+                free_sketches.pop_back();
+            }
+        }
+        std::vector<uint64_t>& out = sketches[n.sketch];
+        out.assign(slot_count, 0);
+        own(x, out);
+        accumulate(n.left, out);
+        accumulate(n.right, out);
+    }
+
+    void drop_sketch(int x) {
+        if (t[x].sketch < 0) return;
+        sketches[t[x].sketch].clear();
+        free_sketches.push_back(t[x].sketch);
+        t[x].sketch = -1;
+    }
+
+    // XOR the entries below x (x included) into out
+    void accumulate(int x, std::vector<uint64_t>& out) const {
+        if (x < 0) return;
+        if (t[x].sketch >= 0) {
+            const std::vector<uint64_t>& s = sketches[t[x].sketch];
+            for (std::size_t i = 0; i < s.size(); i++) out[i] ^= s[i];
+            return;
+        }
+        own(x, out);
+        accumulate(t[x].left, out);
+        accumulate(t[x].right, out);
+    }
+
+    void own(int x, std::vector<uint64_t>& out) const {
+        const Node& n = t[x];
+        if (n.chunk < 0) return;
+        const std::vector<Entry>& list = entries[n.vertex];
+        std::size_t begin = static_cast<std::size_t>(n.chunk) * CHUNK;
+        std::size_t end = std::min(list.size(), begin + CHUNK);
+        for (std::size_t p = begin; p < end; p++) out[list[p].slot] ^= list[p].tag;
+    }
+
+    // Entry (slot, tag) of chunk x appeared or went away
+    void toggle(int x, uint32_t slot, uint64_t tag) {
+        if (!sketching) return;
+        for (; x >= 0; x = t[x].parent) {
+            if (t[x].sketch >= 0) sketches[t[x].sketch][slot] ^= tag;
+        }
+    }
+
+    void rebuild(int x) {
+        if (x < 0) return;
+        rebuild(t[x].left);
+        rebuild(t[x].right);
+        pull(x);
+    }
+};
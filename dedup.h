@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "edge_store.h"
+#include "parallel.h"
+#include "radix_sort.h"
+
+// Optional preprocessing pass that removes self-loops and parallel edges
+// before the edge list reaches sort and DSU (--dedup in the programs that
+// support it).
+//
+// Every edge is canonicalized to (min(u, v), max(u, v)) and the ids are radix
+// sorted by that pair (stable, so a pair's copies stay in input order). Each
+// pair then keeps one copy: the lightest, or the heaviest with keep_max (for
+// maximum spanning forests), ties going to the earliest input position. The
+// group scan runs in parallel; a chunk handles the groups that start inside it.
+//
+// Nothing is reordered or renumbered: the result lists the surviving input
+// ids and, for every input edge, what happened to it, so programs that print
+// one line per input edge can still answer for the dropped copies.
+
+const uint32_t DEDUP_SELF_LOOP = UINT32_MAX;     // u == v
+const uint32_t DEDUP_DOMINATED = UINT32_MAX - 1; // A strictly better copy of the pair was kept
+
+struct DedupStats {
+    std::size_t edges_total = 0;
+    std::size_t self_loops = 0;
+    std::size_t dominated = 0;
+    std::size_t tied = 0; // Dropped copies with the same weight as the kept one
+    std::size_t kept = 0;
+
+    double reduction() const { return edges_total ? 1.0 - double(kept) / double(edges_total) : 0.0; }
+};
+
+struct DedupResult {
+    std::vector<uint32_t> kept; // Surviving edge ids, ascending
+    // Per input edge: its own id if kept, the id of the kept copy it ties
+    // with, DEDUP_DOMINATED or DEDUP_SELF_LOOP
+    std::vector<uint32_t> rep;
+    DedupStats stats;
+};
+
+inline void print_dedup_stats(const DedupStats& s) {
+    std::cerr << "dedup: m = " << s.edges_total << " -> " << s.kept << " (" << std::fixed << std::setprecision(2)
+              << 100.0 * s.reduction() << "% removed: self-loops " << s.self_loops << ", dominated "
+              << s.dominated << ", tied " << s.tied << ")\n"
+              << std::defaultfloat;
+}
+
+template <typename Edges, typename WeightOf>
+DedupResult dedup_edges(const Edges& edges, WeightOf weight_of, bool keep_max = false, unsigned num_threads = 0) {
+    const std::size_t m = edges.size();
+    const unsigned threads = resolve_thread_count(m, num_threads, 1 << 16);
+
+    auto pair_key = [&](std::size_t i) {
+        uint32_t u = static_cast<uint32_t>(edges[i].u);
+        uint32_t v = static_cast<uint32_t>(edges[i].v);
+        return u < v ? (uint64_t(u) << 32) | v : (uint64_t(v) << 32) | u;
+    };
+    std::vector<uint32_t> order = radix_sort_keys<uint64_t>(m, pair_key, threads);
+
+    DedupResult result;
+    result.rep.resize(m);
+    auto better = [&](auto a, auto b) { return keep_max ? b < a : a < b; };
+
+    parallel_chunks(m, threads, [&](unsigned, std::size_t begin, std::size_t end) {
+        // Skip the tail of a group that started in the previous chunk
+        std::size_t i = begin;
+        while (i > 0 && i < end && pair_key(order[i]) == pair_key(order[i - 1])) i++;
+
+        while (i < end) {
+            const uint64_t key = pair_key(order[i]);
+            std::size_t j = i + 1;
+            while (j < m && pair_key(order[j]) == key) j++;
+
+            if (edges[order[i]].u == edges[order[i]].v) {
+                for (std::size_t k = i; k < j; k++) result.rep[order[k]] = DEDUP_SELF_LOOP;
+            } else {
+                uint32_t best = order[i];
+                for (std::size_t k = i + 1; k < j; k++) {
+                    if (better(weight_of(edges[order[k]]), weight_of(edges[best]))) best = order[k];
+                }
+                auto best_w = weight_of(edges[best]);
+                for (std::size_t k = i; k < j; k++) {
+                    auto w = weight_of(edges[order[k]]);
+                    result.rep[order[k]] = (w < best_w || best_w < w) ? DEDUP_DOMINATED : best;
+                }
+            }
+            i = j;
+        }
+    });
+
+    // Survivors in input order: count per chunk, then fill
+    std::vector<std::size_t> count(threads + 1, 0);
+    parallel_chunks(m, threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+        std::size_t k = 0;
+        for (std::size_t i = begin; i < end; i++) k += result.rep[i] == i;
+        count[t + 1] = k;
+    });
+    for (unsigned t = 0; t < threads; t++) count[t + 1] += count[t];
+    result.kept.resize(count[threads]);
+    parallel_chunks(m, threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+        std::size_t out = count[t];
+        for (std::size_t i = begin; i < end; i++) {
+            if (result.rep[i] == i) result.kept[out++] = static_cast<uint32_t>(i);
+        }
+    });
+
+    DedupStats& s = result.stats;
+    s.edges_total = m;
+    s.kept = result.kept.size();
+    for (std::size_t i = 0; i < m; i++) {
+        if (result.rep[i] == DEDUP_SELF_LOOP) s.self_loops++;
+        else if (result.rep[i] == DEDUP_DOMINATED) s.dominated++;
+    }
+    s.tied = m - s.kept - s.self_loops - s.dominated;
+    return result;
+}
+
+// Drop everything dedup_edges did not keep, preserving input order
+template <typename E>
+void keep_edges(std::vector<E>& edges, const std::vector<uint32_t>& kept) {
+    for (std::size_t k = 0; k < kept.size(); k++) edges[k] = edges[kept[k]];
+    edges.resize(kept.size());
+}
+
+template <typename W>
+void keep_edges(EdgeStore<W>& edges, const std::vector<uint32_t>& kept) {
+    for (std::size_t k = 0; k < kept.size(); k++) edges.set(k, edges.u[kept[k]], edges.v[kept[k]], edges.w[kept[k]]);
+    edges.resize(kept.size());
+}
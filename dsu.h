@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Disjoint Set Union (DSU) shared by every program in this repo.
+//
+// Layout: one signed integer per node.
+//   parent[i] >= 0  -> i is not a root, parent[i] is the next node up
+//   parent[i] <  0  -> i is a root and -parent[i] is the size of its set
+//
+// DSU(n) is sized for n nodes indexed either 0..n-1 or 1..n (one spare slot
+// is allocated so both conventions work), and starts with n components.
+
+// Component counter is compiled in only when asked for
+template <typename Index, bool Enabled>
+struct DSUComponentCounter {
+    void reset_count(std::size_t) {}
+    void on_merge() {}
+    void on_split() {}
+};
+
+template <typename Index>
+struct DSUComponentCounter<Index, true> {
+    Index num_components = 0; // Number of disjoint sets among the n nodes
+
+    void reset_count(std::size_t n) { num_components = static_cast<Index>(n); }
+    void on_merge() { num_components--; }
+    void on_split() { num_components++; }
+};
+
+template <typename Index = int32_t, bool TrackComponents = true>
+struct BasicDSU : DSUComponentCounter<Index, TrackComponents> {
+    std::vector<Index> parent;
+
+    explicit BasicDSU(std::size_t n = 0) { reset(n); }
+
+    void reset(std::size_t n) {
+        parent.assign(n + 1, -1);
+        this->reset_count(n);
+    }
+
+    // Iterative find with path halving: every visited node is pointed at its
+    // grandparent, so there is no recursion and chains flatten as we go
+    Index find(Index i) {
+        while (parent[i] >= 0) {
+            Index p = parent[i];
+            if (parent[p] < 0) return p;
+            parent[i] = parent[p];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    // Union by size; returns true if a and b were in different sets
+    bool unite(Index a, Index b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (parent[a] > parent[b]) std::swap(a, b); // a is the larger set
+        parent[a] += parent[b];
+        parent[b] = a;
+        this->on_merge();
+        return true;
+    }
+
+    bool same(Index a, Index b) { return find(a) == find(b); }
+
+    Index size(Index i) { return -parent[find(i)]; }
+};
+
+// Union-find that can undo its unions, newest first. There is no path
+// compression (it would make undo impossible), so find is O(log n) from union
+// by size alone. checkpoint() marks the current state; rollback(to) undoes
+// every union made since, O(1) each.
+template <typename Index = int32_t, bool TrackComponents = true>
+struct BasicRollbackDSU : DSUComponentCounter<Index, TrackComponents> {
+    std::vector<Index> parent; // Same layout as BasicDSU
+
+    struct Undo {
+        Index child;      // Root that was hung below another root
+        Index child_size; // Its parent[] entry before that (-size)
+    };
+    std::vector<Undo> history;
+
+    explicit BasicRollbackDSU(std::size_t n = 0) { reset(n); }
+
+    void reset(std::size_t n) {
+        parent.assign(n + 1, -1);
+        history.clear();
+        this->reset_count(n);
+    }
+
+    Index find(Index i) const {
+        while (parent[i] >= 0) i = parent[i];
+        return i;
+    }
+
+    // Union by size; returns true (and logs the union) if a and b were in
+    // different sets
+    bool unite(Index a, Index b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (parent[a] > parent[b]) std::swap(a, b); // a is the larger set
+        history.push_back({b, parent[b]});
+        parent[a] += parent[b];
+        parent[b] = a;
+        this->on_merge();
+        return true;
+    }
+
+    bool same(Index a, Index b) const { return find(a) == find(b); }
+
+    Index size(Index i) const { return -parent[find(i)]; }
+
+    std::size_t checkpoint() const { return history.size(); }
+
+    void rollback(std::size_t to) {
+        while (history.size() > to) {
+            Undo u = history.back();
+            history.pop_back();
+            parent[parent[u.child]] -= u.child_size;
+            parent[u.child] = u.child_size;
+            this->on_split();
+        }
+    }
+};
+
+// Persistent (versioned) union-find. Version 0 has every node on its own and
+// every successful unite() creates the next version; find, same and size can
+// ask about any version so far. With union by size and no path compression a
+// node gets a parent exactly once, so its fat node is just (parent, version
+// it was linked in); set sizes keep a (version, size) history per root, empty
+// while the root is a singleton. Queries are O(log n) and const: any number
+// of threads can query past versions at once, as long as nobody calls
+// unite() meanwhile.
+template <typename Index = int32_t>
+struct BasicPersistentDSU {
+    static constexpr uint32_t NEVER = UINT32_MAX;
+
+    std::vector<Index> parent;       // Meaningful once linked_at[i] != NEVER
+    std::vector<uint32_t> linked_at; // Version in which i stopped being a root
+    std::vector<std::vector<std::pair<uint32_t, Index>>> sizes; // Root -> (version, size from then on)
+    uint32_t current = 0;
+
+    explicit BasicPersistentDSU(std::size_t n = 0) { reset(n); }
+
+    void reset(std::size_t n) {
+        parent.assign(n + 1, 0);
+        linked_at.assign(n + 1, NEVER);
+        sizes.assign(n + 1, {});
+        current = 0;
+    }
+
+    uint32_t version() const { return current; }
+
+    Index find(Index i, uint32_t v) const {
+        while (linked_at[i] <= v) i = parent[i];
+        return i;
+    }
+    Index find(Index i) const { return find(i, current); }
+
+    bool same(Index a, Index b, uint32_t v) const { return find(a, v) == find(b, v); }
+    bool same(Index a, Index b) const { return same(a, b, current); }
+
+    Index size(Index i, uint32_t v) const {
+        const auto& h = sizes[find(i, v)];
+        auto it = std::upper_bound(h.begin(), h.end(), v,
+                                   [](uint32_t x, const std::pair<uint32_t, Index>& e) { return x < e.first; });
+        return it == h.begin() ? 1 : std::prev(it)->second;
+    }
+    Index size(Index i) const { return size(i, current); }
+
+    // Union by size; returns true (and creates a new version) if a and b
+    // were in different sets
+    bool unite(Index a, Index b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        Index size_a = size(a), size_b = size(b);
+        if (size_a < size_b) std::swap(a, b);
+        current++;
+        parent[b] = a;
+        linked_at[b] = current;
+        sizes[a].push_back({current, size_a + size_b});
+        return true;
+    }
+};
+
+using DSU = BasicDSU<int32_t>;   // Default: 32-bit indices, counts components
+using DSU64 = BasicDSU<int64_t>; // For graphs with more than 2^31 nodes
+using RollbackDSU = BasicRollbackDSU<int32_t>;
+using PersistentDSU = BasicPersistentDSU<int32_t>;
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "cut_sketch.h"
+#include "edge_store.h"
+#include "link_cut_tree.h"
+
+// Fully dynamic minimum spanning forest: edge insertion and deletion, weight
+// increases and decreases, with the forest weight available after each.
+//
+// The forest lives in a link-cut tree (one node per vertex, one per tree
+// edge), which gives the heaviest edge on any tree path in O(log n). Making
+// an edge cheaper, or inserting one, is then a single path-max query and at
+// most one swap.
+//
+// Making a tree edge heavier, or deleting it, needs the lightest non-tree edge
+// across the cut. The non-tree edges are kept in (weight, id) order, cut into
+// consecutive buckets of about sqrt(m) edges, and the forest is mirrored in a
+// CutSketchForest (cut_sketch.h) with one sketch slot per bucket. After the
+// cut, the sketch of one side says for every bucket at once whether any of
+// its edges crosses; only the lightest such bucket is scanned, in order, for
+// the first edge whose ends the forest puts on different sides. A
+// replacement costs O(sqrt(m) log n) whatever the shape of the cut, and ties
+// prefer the lower edge id.
+
+template <typename W>
+struct DynamicMST {
+    // Path-max key of a tree edge; vertex nodes get the lowest possible key
+    struct Key {
+        W w;
+        uint32_t id;
+        bool operator<(const Key& o) const { return w < o.w || (w == o.w && id < o.id); }
+    };
+
+    enum Status : uint8_t { NON_TREE, TREE, DELETED };
+    static constexpr uint32_t NO_EDGE = UINT32_MAX;
+
+    int n = 0;
+    EdgeStore<W> edges; // Every edge ever inserted; id = position
+    std::vector<uint8_t> status;
+    std::vector<int32_t> lct_node; // Tree edge -> its link-cut node
+    std::vector<int32_t> free_nodes;
+    LinkCutTree<Key> lct;
+    CutSketchForest cuts; // The same forest, with the non-tree edges' sketches
+    std::set<Key> non_tree;
+    long long weight = 0; // Total weight of the forest
+
+    // Buckets: consecutive runs of non_tree, each a sketch slot. Self-loops
+    // never cross a cut and stay out of them.
+    std::map<Key, uint32_t> bucket_start; // Lightest key of a bucket -> its slot
+    std::vector<uint32_t> bucket_size;    // Per slot
+    std::vector<uint32_t> free_slots;
+    std::vector<uint32_t> slot_of;        // Non-tree edge -> its bucket's slot
+    uint32_t bucket_target = 64;
+    uint64_t tag_key = 0;                 // Secret of tag_of()
+
+    // edges: the initial graph; tree: its spanning forest (any order)
+    void init(int num_nodes, EdgeStore<W> initial, const std::vector<uint32_t>& tree) {
+        n = num_nodes;
+        edges = std::move(initial);
+        const std::size_t m = edges.size();
+        status.assign(m, NON_TREE);
+        lct_node.assign(m, -1);
+        slot_of.assign(m, 0);
+        lct = LinkCutTree<Key>(n + 1, Key{std::numeric_limits<W>::lowest(), 0});
+        bucket_target = std::max<uint32_t>(64, static_cast<uint32_t>(std::sqrt(static_cast<double>(m))));
+        cuts = CutSketchForest(n, 2 * bucket_target);
+        tag_key = CutSketchForest::random_key();
+        non_tree.clear();
+        bucket_start.clear();
+        bucket_size.clear();
+        free_slots.clear();
+        weight = 0;
+
+        // Sketches are computed once everything is in place
+        for (uint32_t id : tree) link_edge(id);
+        for (uint32_t id = 0; id < m; id++) {
+            if (status[id] == NON_TREE) add_non_tree(id);
+        }
+        cuts.enable_sketches();
+    }
+
+    // New edge; returns its id
+    uint32_t insert(int32_t u, int32_t v, W w) {
+        uint32_t id = edges.size();
+        edges.push_back(u, v, w);
+        status.push_back(NON_TREE);
+        lct_node.push_back(-1);
+        slot_of.push_back(0);
+        offer(id);
+        return id;
+    }
+
+    void erase(uint32_t id) {
+        if (status[id] == DELETED) return;
+        if (status[id] == TREE) {
+            cut_edge(id);
+            uint32_t r = replacement(edges.u[id], std::numeric_limits<W>::max(), true);
+            if (r != NO_EDGE) promote(r);
+        } else {
+            remove_non_tree(id);
+        }
+        status[id] = DELETED;
+    }
+
+    void set_weight(uint32_t id, W w) {
+        if (status[id] == DELETED) return;
+        W old = edges.w[id];
+        if (status[id] == NON_TREE) {
+            remove_non_tree(id);
+            edges.w[id] = w;
+            offer(id);
+        } else if (!(old < w)) {
+            // A tree edge getting cheaper stays in the tree
+            edges.w[id] = w;
+            weight += (long long)w - (long long)old;
+            lct.set_key(lct_node[id], Key{w, id});
+        } else {
+            // A tree edge getting heavier: swap in a strictly lighter
+            // replacement if the cut has one
+            cut_edge(id);
+            uint32_t r = replacement(edges.u[id], w, false);
+            edges.w[id] = w;
+            if (r != NO_EDGE) {
+                promote(r);
+                add_non_tree(id);
+            } else {
+                link_edge(id);
+            }
+        }
+    }
+
+private:
+    Key key_of(uint32_t id) const { return Key{edges.w[id], id}; }
+
+    void link_edge(uint32_t id) {
+        int node;
+        if (free_nodes.empty()) {
+            node = lct.add_node(key_of(id));
+        } else {
+            node = free_nodes.back();
+            free_nodes.pop_back();
+            lct.reset_node(node, key_of(id));
+        }
+        lct_node[id] = node;
+        lct.link(edges.u[id], node);
+        lct.link(node, edges.v[id]);
+        cuts.link(id, edges.u[id], edges.v[id]);
+        status[id] = TREE;
+        weight += edges.w[id];
+    }
+
+    void cut_edge(uint32_t id) {
+        int node = lct_node[id];
+        lct.cut(edges.u[id], node);
+        lct.cut(node, edges.v[id]);
+        free_nodes.push_back(node);
+        lct_node[id] = -1;
+        cuts.cut(id);
+        status[id] = NON_TREE;
+        weight -= edges.w[id];
+    }
+
+    // Tag of an edge in the cut sketches: splitmix64 of the id under a key
+    // drawn per run, so no input can pick ids whose tags cancel
+    uint64_t tag_of(uint32_t id) const {
+        uint64_t z = tag_key + (static_cast<uint64_t>(id) + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    void add_non_tree(uint32_t id) {
+        status[id] = NON_TREE;
+        int32_t u = edges.u[id], v = edges.v[id];
+        if (u == v) return;
+        Key key = key_of(id);
+        non_tree.insert(key);
+
+        // Into the bucket with the greatest start <= key; a key below every
+        // start becomes the first bucket's start
+        auto b = bucket_start.upper_bound(key);
+        if (b != bucket_start.begin()) {
+            --b;
+        } else {
+            uint32_t slot = b == bucket_start.end() ? new_slot() : b->second;
+            if (b != bucket_start.end()) bucket_start.erase(b);
+            b = bucket_start.emplace(key, slot).first;
+        }
+        uint32_t slot = b->second;
+        slot_of[id] = slot;
+        bucket_size[slot]++;
+        cuts.add_end(u, 2 * id, slot, tag_of(id));
+        cuts.add_end(v, 2 * id + 1, slot, tag_of(id));
+        if (bucket_size[slot] > 2 * bucket_target) split_bucket(b);
+    }
+
+    void remove_non_tree(uint32_t id) {
+        int32_t u = edges.u[id], v = edges.v[id];
+        if (u == v) return;
+        Key key = key_of(id);
+        uint32_t slot = slot_of[id];
+        auto b = std::prev(bucket_start.upper_bound(key));
+        cuts.remove_end(u, 2 * id);
+        cuts.remove_end(v, 2 * id + 1);
+        auto next = non_tree.erase(non_tree.find(key));
+        bucket_size[slot]--;
+
+        if (b->first.id == id) {
+            // It started its bucket: now the next key does, unless it was the last
+            bucket_start.erase(b);
+            if (bucket_size[slot] == 0) {
+                free_slots.push_back(slot);
+                return;
+            }
+            b = bucket_start.emplace(*next, slot).first;
+        }
+        if (bucket_size[slot] < bucket_target / 4) merge_bucket(b);
+    }
+
+    uint32_t new_slot() {
+        if (free_slots.empty()) {
+            bucket_size.push_back(0);
+            cuts.reserve_slots(static_cast<uint32_t>(bucket_size.size()));
+            return static_cast<uint32_t>(bucket_size.size() - 1);
+        }
+        uint32_t slot = free_slots.back();
+        free_slots.pop_back();
+        return slot;
+    }
+
+    // Moves count non-tree edges, from the one with key 'from' on, to slot
+    void move_run(const Key& from, uint32_t count, uint32_t slot) {
+        auto it = non_tree.find(from);
+        for (uint32_t k = 0; k < count; k++, ++it) {
+            uint32_t id = it->id;
+            bucket_size[slot_of[id]]--;
+            bucket_size[slot]++;
+            slot_of[id] = slot;
+            cuts.set_slot(edges.u[id], 2 * id, slot);
+            cuts.set_slot(edges.v[id], 2 * id + 1, slot);
+        }
+    }
+
+    // An oversized bucket hands its heavier half to a new one
+    void split_bucket(typename std::map<Key, uint32_t>::iterator b) {
+        uint32_t size = bucket_size[b->second];
+        auto middle = std::next(non_tree.find(b->first), size / 2);
+        Key from = *middle;
+        move_run(from, size - size / 2, new_slot());
+        bucket_start.emplace(from, slot_of[from.id]);
+    }
+
+    // A small bucket absorbs the next one (or is absorbed by the previous one)
+    void merge_bucket(typename std::map<Key, uint32_t>::iterator b) {
+        if (std::next(b) == bucket_start.end()) {
+            if (b == bucket_start.begin()) return;
+            --b;
+        }
+        auto absorbed = std::next(b);
+        uint32_t slot = absorbed->second;
+        move_run(absorbed->first, bucket_size[slot], b->second);
+        free_slots.push_back(slot);
+        bucket_start.erase(absorbed);
+        if (bucket_size[b->second] > 2 * bucket_target) split_bucket(b);
+    }
+
+    // Non-tree edge id moves into the forest
+    void promote(uint32_t id) {
+        remove_non_tree(id);
+        link_edge(id);
+    }
+
+    // Edge id (currently in no structure) becomes a tree or non-tree edge
+    void offer(uint32_t id) {
+        int32_t u = edges.u[id], v = edges.v[id];
+        if (u != v && !lct.connected(u, v)) {
+            link_edge(id);
+            return;
+        }
+        if (u != v) {
+            Key heaviest = lct.path_max(u, v);
+            if (edges.w[id] < heaviest.w) {
+                cut_edge(heaviest.id);
+                link_edge(id);
+                add_non_tree(heaviest.id);
+                return;
+            }
+        }
+        add_non_tree(id);
+    }
+
+    // Lightest non-tree edge leaving a's tree (just cut off its other half)
+    // with weight < bound (any weight if unbounded); NO_EDGE if there is none
+    uint32_t replacement(int32_t a, W bound, bool unbounded) {
+        const std::vector<uint64_t>& leaving = cuts.tree_sketch(a);
+        for (auto bucket = bucket_start.begin(); bucket != bucket_start.end(); ++bucket) {
+            if (!unbounded && !(bucket->first.w < bound)) break;
+            uint32_t slot = bucket->second;
+            if (leaving[slot] == 0) continue;
+
+            // Some edge of this bucket crosses: the first one in order is the answer
+            auto it = non_tree.find(bucket->first);
+            for (uint32_t k = 0; k < bucket_size[slot]; k++, ++it) {
+                uint32_t id = it->id;
+                if (!unbounded && !(edges.w[id] < bound)) return NO_EDGE;
+                if (cuts.connected(edges.u[id], a) != cuts.connected(edges.v[id], a)) return id;
+            }
+        }
+        return NO_EDGE;
+    }
+};
@@ -2,189 +2,145 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
-#include <queue>
 
-using namespace std;
-
-const int INF = 1e9;
-
-struct Edge {
-    int u, v, w;
-    int id;
-};
+#include "dynamic_mst.h"
+#include "edge_store.h"
+#include "fast_input.h"
+#include "fast_output.h"
+#include "mst.h"
+#include "offline_mst.h"
 
-// Comparator for initial Kruskal's
-bool compareEdges(const Edge &a, const Edge &b) {
-    return a.w < b.w;
-}
+using namespace std;
 
-// Disjoint Set Union (DSU)
-struct DSU {
-    vector<int> parent;
-    DSU(int n) {
-        parent.resize(n + 1);
-        iota(parent.begin(), parent.end(), 0);
-    }
-    int find(int i) {
-        if (parent[i] == i) return i;
-        return parent[i] = find(parent[i]);
-    }
-    bool unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-            return true;
-        }
-        return false;
-    }
-};
+// Query formats (one MST cost printed per query):
+//   default : "edge_idx delta"       change the weight of edge edge_idx (1-based) by delta;
+//                                    delta may be negative
+//   --ops   : "1 edge_idx delta"     same as above
+//             "2 u v w"              insert a new edge; it gets the next index (M + 1, M + 2, ...)
+//             "3 edge_idx"           delete edge edge_idx
+// If edges are deleted until the graph falls apart, the cost is that of the
+// minimum spanning forest.
+//
+// --offline reads every query first and answers them together by divide and
+// conquer over time (see offline_mst.h); the output is the same.
+enum Op { CHANGE = 1, INSERT = 2, DELETE = 3 };
 
 // Global State
 int N, M, Q;
-vector<Edge> all_edges;       // Stores all edges (0-indexed by input order)
-vector<bool> is_in_mst;       // Tracks if edge[i] is currently in MST
-vector<int> mst_adj[205];     // Adjacency list for current MST
-long long current_mst_cost = 0;
-
-// Helper to rebuild adjacency list (optional, but keeps logic clean)
-void rebuild_adj() {
-    for (int i = 0; i <= N; ++i) mst_adj[i].clear();
-    for (const auto& edge : all_edges) {
-        if (is_in_mst[edge.id]) {
-            mst_adj[edge.u].push_back(edge.v);
-            mst_adj[edge.v].push_back(edge.u);
-        }
-    }
-}
+DynamicMST<long long> mst; // Current MST, updated online (see dynamic_mst.h)
 
-// Run standard Kruskal's once at the start
-void initial_kruskal() {
-    vector<Edge> sorted_edges = all_edges;
-    sort(sorted_edges.begin(), sorted_edges.end(), compareEdges);
-    
-    DSU dsu(N);
-    is_in_mst.assign(M, false);
-    
-    for (const auto& edge : sorted_edges) {
-        if (dsu.unite(edge.u, edge.v)) {
-            current_mst_cost += edge.w;
-            is_in_mst[edge.id] = true;
-        }
-    }
-    rebuild_adj();
+// Build the initial MST once at the start (Filter-Kruskal unless --engine says otherwise)
+void initial_kruskal(const MSTOptions& opt, EdgeStore<long long> all_edges) {
+    vector<uint32_t> tree = build_mst(opt, all_edges, N, [](const EdgeRef<long long>& e) { return e.w; });
+    mst.init(N, move(all_edges), tree);
 }
 
-// BFS to find all nodes reachable from 'start_node' 
-// WITHOUT using the edge connecting 'u' and 'v' (effectively finding one cut component)
-void get_component(int start_node, int avoid_node, vector<bool>& visited) {
-    queue<int> q;
-    q.push(start_node);
-    visited[start_node] = true;
-    
-    while (!q.empty()) {
-        int curr = q.front();
-        q.pop();
-        
-        for (int neighbor : mst_adj[curr]) {
-            if (neighbor == avoid_node) continue; // Don't cross the removed edge
-            if (!visited[neighbor]) {
-                visited[neighbor] = true;
-                q.push(neighbor);
+// Read all queries, turn them into absolute updates and answer them in one go
+void answer_offline(FastInput& in, bool ops, EdgeStore<long long> all_edges) {
+    vector<uint8_t> present(M, 1);
+    vector<uint8_t> alive(M, 1);      // Existence as the queries are read
+    vector<long long> w(all_edges.w); // Weight as the queries are read
+    vector<MSTUpdate<long long>> updates(Q, {MSTUpdate<long long>::NONE, false, 0});
+    for (int k = 0; k < Q; ++k) {
+        int op = CHANGE;
+        if (ops) in.read(op);
+
+        if (op == INSERT) {
+            int u = 0, v = 0;
+            long long weight = 0;
+            in.read(u, v, weight);
+            uint32_t id = all_edges.size();
+            all_edges.push_back(u, v, weight); // Absent until now
+            present.push_back(0);
+            alive.push_back(1);
+            w.push_back(weight);
+            updates[k] = {id, true, weight};
+        } else if (op == DELETE) {
+            int edge_idx = 0;
+            in.read(edge_idx);
+            int id = edge_idx - 1;
+            if (id >= 0 && id < (int)alive.size() && alive[id]) {
+                alive[id] = 0;
+                updates[k] = {(uint32_t)id, false, w[id]};
+            }
+        } else {
+            int edge_idx = 0;
+            long long added_weight = 0;
+            in.read(edge_idx, added_weight);
+            int id = edge_idx - 1;
+            if (id >= 0 && id < (int)alive.size() && alive[id]) {
+                w[id] += added_weight;
+                updates[k] = {(uint32_t)id, true, w[id]};
             }
         }
     }
+
+    OfflineMST<long long> solver;
+    vector<long long> cost = solver.run(N, all_edges, move(present), updates);
+    FastOutput out;
+    for (long long c : cost) {
+        out.write_int(c);
+        out.put('\n');
+    }
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Fast I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    if (!(cin >> N >> M >> Q)) return 0;
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    if (!in.read(N, M, Q)) return 0;
 
-    for (int i = 0; i < M; ++i) {
-        int u, v, w;
-        cin >> u >> v >> w;
-        all_edges.push_back({u, v, w, i});
+    EdgeStore<long long> all_edges; // Stores all edges (id = position in input order)
+    all_edges.resize(M);
+    in.read_records<int, int, long long>(M, [&](size_t i, int u, int v, long long w) {
+        all_edges.set(i, u, v, w);
+    });
+
+    bool ops = has_flag(argc, argv, "--ops");
+    if (has_flag(argc, argv, "--offline")) {
+        answer_offline(in, ops, move(all_edges));
+        return 0;
     }
 
     // Step 1: Compute Initial MST
-    initial_kruskal();
+    // --engine=kruskal|filter|boruvka, --threads=N, --stats (see mst.h)
+    initial_kruskal(parse_mst_options(argc, argv), move(all_edges));
 
     // Step 2: Process Queries
+    // Each update costs a few link-cut and Euler tour tree operations plus a
+    // scan of one weight bucket, O(sqrt(M) log N), instead of a BFS over the
+    // tree plus a pass over every edge
+    FastOutput out;
     for (int k = 0; k < Q; ++k) {
-        int edge_idx, added_weight;
-        cin >> edge_idx >> added_weight;
-        int id = edge_idx - 1; // Convert 1-based to 0-based
-
-        // Update the weight permanently
-        all_edges[id].w += added_weight;
-
-        // CASE 1: Edge is NOT in MST
-        // Increasing its weight makes it even less likely to be useful.
-        // Cost remains the same.
-        if (!is_in_mst[id]) {
-            cout << current_mst_cost << "\n";
-            continue;
-        }
-
-        // CASE 2: Edge IS in MST
-        // We tentatively increase the MST cost
-        current_mst_cost += added_weight;
-
-        // We need to check if we can swap this edge for a cheaper one.
-        // The edge connects u and v. Removing it splits the tree.
-        int u = all_edges[id].u;
-        int v = all_edges[id].v;
-
-        // Find which nodes are in u's component after cutting the edge
-        vector<bool> in_u_component(N + 1, false);
-        get_component(u, v, in_u_component);
-
-        // Find the best replacement edge
-        int best_replacement_id = -1;
-        int min_replacement_w = INF;
-
-        for (const auto& edge : all_edges) {
-            // We are looking for an edge that crosses the cut:
-            // One endpoint is in u's component, the other is NOT (i.e., in v's component)
-            bool u_side = in_u_component[edge.u];
-            bool v_side = in_u_component[edge.v];
-
-            if (u_side != v_side) {
-                // This edge crosses the cut.
-                // It must be cheaper than the current (now increased) weight of our MST edge.
-                // And it shouldn't be the edge itself (though checking edge.id != id is implicit by weight logic usually)
-                if (edge.id != id && edge.w < min_replacement_w) {
-                    min_replacement_w = edge.w;
-                    best_replacement_id = edge.id;
-                }
-            }
-        }
-
-        // Swap if a better edge exists
-        // Note: We only swap if the replacement is STRICTLY better than the NEW weight of the current edge
-        if (best_replacement_id != -1 && min_replacement_w < all_edges[id].w) {
-            
-            // Adjust Cost
-            current_mst_cost -= all_edges[id].w;       // Remove expensive edge
-            current_mst_cost += min_replacement_w;     // Add cheap replacement
-            
-            // Update Structure
-            is_in_mst[id] = false;
-            is_in_mst[best_replacement_id] = true;
-            
-            // Update Adjacency List for next query
-            // (We handle the specific remove/add carefully to avoid full rebuild for speed, 
-            //  but full rebuild is fine for N=200. Here we do targeted update).
-            
-            // Remove u-v
-            // (Simpler to just call rebuild_adj() for safety given small N)
-            rebuild_adj();
+        int op = CHANGE;
+        if (ops) in.read(op);
+
+        if (op == INSERT) {
+            int u = 0, v = 0;
+            long long w = 0;
+            in.read(u, v, w);
+            mst.insert(u, v, w);
+        } else if (op == DELETE) {
+            int edge_idx = 0;
+            in.read(edge_idx);
+            int id = edge_idx - 1; // Convert 1-based to 0-based
+            if (id >= 0 && id < (int)mst.edges.size()) mst.erase(id);
+        } else {
+            int edge_idx = 0;
+            long long added_weight = 0;
+            in.read(edge_idx, added_weight);
+            int id = edge_idx - 1; // Convert 1-based to 0-based
+
+            // Update the weight permanently. A heavier tree edge is swapped
+            // for a STRICTLY lighter edge across its cut, if there is one;
+            // a lighter non-tree edge replaces the heaviest edge on its cycle
+            if (id >= 0 && id < (int)mst.edges.size()) mst.set_weight(id, mst.edges.w[id] + added_weight);
         }
 
-        cout << current_mst_cost << "\n";
+        out.write_int(mst.weight);
+        out.put('\n');
     }
 
     return 0;
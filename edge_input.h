@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "cli.h"
+#include "edge_store.h"
+#include "fast_input.h"
+#include "graph_file.h"
+
+// Input layer for the programs whose input starts with "n m" followed by m
+// "u v w" lines. By default the text comes from the FastInput (stdin, or the
+// file given by --input=path); with --graph=path a binary graph file
+// (graph_file.h, written by edgelist_to_bin) is mapped instead and nothing is
+// parsed. Anything after the edge list (query blocks) is read from the
+// FastInput as usual.
+//
+// What ends up in memory depends on the container the program asks for:
+//   GraphEdges<W>      read-only; a mapped file is used in place (zero copies)
+//                      when it stores W, only the weight column is converted
+//                      otherwise
+//   EdgeStore<W>       the mapped columns are copied once (m x (8 + sizeof W)
+//                      bytes), since its owners append, reweight or compact
+//   std::vector<Edge>  copied into the program's structs, which it then sorts
+//                      or rewrites in place
+// Only GraphEdges keeps resident memory at the size of the file's pages.
+
+// Copy the mapped columns into an Edge vector (fields u, v, w)
+template <typename E>
+void gather_graph_edges(const GraphFile& g, std::vector<E>& edges) {
+    using W = decltype(E::w);
+    const std::size_t m = g.m();
+    edges.resize(m);
+
+    auto copy = [&](const auto* w) {
+        for (std::size_t i = 0; i < m; i++) {
+            edges[i].u = g.u[i];
+            edges[i].v = g.v[i];
+            edges[i].w = static_cast<W>(w[i]);
+        }
+    };
+    switch (g.weight_type()) {
+        case WeightType::Int32: copy(g.weights<int32_t>()); break;
+        case WeightType::Int64: copy(g.weights<int64_t>()); break;
+        case WeightType::Float64: copy(g.weights<double>()); break;
+    }
+}
+
+// Copy the mapped columns into an EdgeStore (endpoint columns are copied as is)
+template <typename W>
+void gather_graph_edges(const GraphFile& g, EdgeStore<W>& edges) {
+    const std::size_t m = g.m();
+    edges.resize(m);
+    if (m == 0) return;
+    std::memcpy(edges.u.data(), g.u, m * sizeof(int32_t));
+    std::memcpy(edges.v.data(), g.v, m * sizeof(int32_t));
+
+    auto copy = [&](const auto* w) {
+        for (std::size_t i = 0; i < m; i++) edges.w[i] = static_cast<W>(w[i]);
+    };
+    switch (g.weight_type()) {
+        case WeightType::Int32: copy(g.weights<int32_t>()); break;
+        case WeightType::Int64: copy(g.weights<int64_t>()); break;
+        case WeightType::Float64: copy(g.weights<double>()); break;
+    }
+}
+
+// Edge list for programs that only read it. With --graph=path the columns
+// point straight into the mapping (the weight column too when the file stores
+// W); whatever is not mapped lives in store. Read it like an EdgeStore.
+template <typename W>
+struct GraphEdges {
+    using Weight = W;
+
+    GraphFile file;
+    EdgeStore<W> store; // Text input, or weights converted from the file
+    EdgeColumns<W> cols;
+
+    std::size_t size() const { return cols.size(); }
+    EdgeRef<W> operator[](std::size_t i) const { return cols[i]; }
+};
+
+// Returns false if there is no usable input (the programs then exit quietly)
+template <typename E>
+bool read_graph(FastInput& in, int argc, char** argv, int& n, std::vector<E>& edges) {
+    if (const char* path = flag_value(argc, argv, "--graph")) {
+        GraphFile g;
+        if (!g.open(path)) return false;
+        n = static_cast<int>(g.n());
+        gather_graph_edges(g, edges);
+        return true;
+    }
+
+    using W = decltype(E::w);
+    int m;
+    if (!in.read(n, m)) return false;
+    edges.resize(m);
+    in.read_records<int, int, W>(m, [&](std::size_t i, int u, int v, W w) {
+        edges[i].u = u;
+        edges[i].v = v;
+        edges[i].w = w;
+    });
+    return true;
+}
+
+template <typename W>
+bool read_graph(FastInput& in, int argc, char** argv, int& n, EdgeStore<W>& edges) {
+    if (const char* path = flag_value(argc, argv, "--graph")) {
+        GraphFile g;
+        if (!g.open(path)) return false;
+        n = static_cast<int>(g.n());
+        gather_graph_edges(g, edges);
+        return true;
+    }
+
+    int m;
+    if (!in.read(n, m)) return false;
+    edges.resize(m);
+    in.read_records<int, int, W>(m, [&](std::size_t i, int u, int v, W w) { edges.set(i, u, v, w); });
+    return true;
+}
+
+template <typename W>
+bool read_graph(FastInput& in, int argc, char** argv, int& n, GraphEdges<W>& edges) {
+    if (const char* path = flag_value(argc, argv, "--graph")) {
+        GraphFile& g = edges.file;
+        if (!g.open(path)) return false;
+        n = static_cast<int>(g.n());
+        const std::size_t m = g.m();
+        const W* w;
+        if (weight_type_is<W>(g.weight_type())) {
+            w = g.weights<W>();
+        } else {
+            edges.store.w.resize(m);
+            for (std::size_t i = 0; i < m; i++) edges.store.w[i] = g.weight_as<W>(i);
+            w = edges.store.w.data();
+        }
+        edges.cols = {g.u, g.v, w, m};
+        return true;
+    }
+
+    if (!read_graph(in, argc, argv, n, edges.store)) return false;
+    edges.cols = edges.store.columns();
+    return true;
+}
+
+// Keep only the edges at positions kept, in that order (see dedup.h). The
+// survivors are copied out of the mapping into store.
+template <typename W>
+void keep_edges(GraphEdges<W>& edges, const std::vector<uint32_t>& kept) {
+    EdgeStore<W> survivors;
+    survivors.resize(kept.size());
+    for (std::size_t k = 0; k < kept.size(); k++) {
+        EdgeRef<W> e = edges[kept[k]];
+        survivors.set(k, e.u, e.v, e.w);
+    }
+    edges.store = std::move(survivors);
+    edges.cols = edges.store.columns();
+    edges.file.close();
+}
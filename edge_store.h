@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "radix_sort.h"
+
+// Columnar edge container shared by the programs that keep the whole edge
+// list around (dynamicroadchange, oil business, onedgebecomeszero).
+//
+// Endpoints and weights live in separate arrays with 32-bit indices, so an
+// edge costs 8 bytes plus its weight and there is no struct padding. The edge
+// id is its position in the store. Sorted or filtered orders are EdgeViews:
+// one uint32_t per edge pointing back into the store, the edges themselves
+// are never copied. EdgeColumns is a read-only store over columns that live
+// elsewhere (see GraphEdges in edge_input.h).
+//
+// All of them have size() and operator[] returning something with .u .v .w,
+// so they can be handed to the MST engines in mst.h and to radix_sort_order.
+//
+// Usage:
+//   EdgeStore<int> edges;
+//   edges.push_back(u, v, w);
+//   EdgeView<EdgeStore<int>> sorted = sorted_view(edges);   // ascending w
+//   for (size_t k = 0; k < sorted.size(); k++) use(sorted.id(k), sorted[k].w);
+
+template <typename W>
+struct EdgeRef {
+    int32_t u, v;
+    W w;
+};
+
+// Read-only columns owned elsewhere (a mapped graph file, an EdgeStore):
+// same size() and operator[] as EdgeStore, nothing is copied
+template <typename W>
+struct EdgeColumns {
+    using Weight = W;
+
+    const int32_t* u = nullptr;
+    const int32_t* v = nullptr;
+    const W* w = nullptr;
+    std::size_t m = 0;
+
+    std::size_t size() const { return m; }
+    EdgeRef<W> operator[](std::size_t i) const { return {u[i], v[i], w[i]}; }
+};
+
+template <typename W>
+struct EdgeStore {
+    using Weight = W;
+
+    std::vector<int32_t> u, v;
+    std::vector<W> w;
+
+    std::size_t size() const { return w.size(); }
+
+    void resize(std::size_t m) {
+        u.resize(m);
+        v.resize(m);
+        w.resize(m);
+    }
+
+    void reserve(std::size_t m) {
+        u.reserve(m);
+        v.reserve(m);
+        w.reserve(m);
+    }
+
+    void set(std::size_t i, int32_t a, int32_t b, W weight) {
+        u[i] = a;
+        v[i] = b;
+        w[i] = weight;
+    }
+
+    void push_back(int32_t a, int32_t b, W weight) {
+        u.push_back(a);
+        v.push_back(b);
+        w.push_back(weight);
+    }
+
+    EdgeRef<W> operator[](std::size_t i) const { return {u[i], v[i], w[i]}; }
+
+    EdgeColumns<W> columns() const { return {u.data(), v.data(), w.data(), size()}; }
+};
+
+// A subset or reordering of an edge container, stored as positions into it
+template <typename Edges>
+struct EdgeView {
+    const Edges* edges = nullptr;
+    std::vector<uint32_t> ids;
+
+    EdgeView() = default;
+    explicit EdgeView(const Edges& e) : edges(&e) {}
+
+    std::size_t size() const { return ids.size(); }
+    uint32_t id(std::size_t k) const { return ids[k]; }
+    auto operator[](std::size_t k) const { return (*edges)[ids[k]]; }
+
+    void push_back(uint32_t i) { ids.push_back(i); }
+
+    // Stable sort of the view by weight; only the id array is permuted
+    void sort_by_weight(bool descending = false, unsigned num_threads = 0) {
+        std::vector<uint32_t> order =
+            radix_sort_order(*this, [](const auto& e) { return e.w; }, descending, num_threads);
+        std::vector<uint32_t> sorted(ids.size());
+        for (std::size_t k = 0; k < sorted.size(); k++) sorted[k] = ids[order[k]];
+        ids.swap(sorted);
+    }
+};
+
+// All edges of the container ordered by weight (ties by position)
+template <typename Edges>
+EdgeView<Edges> sorted_view(const Edges& edges, bool descending = false, unsigned num_threads = 0) {
+    EdgeView<Edges> view(edges);
+    view.ids = radix_sort_order(edges, [](const auto& e) { return e.w; }, descending, num_threads);
+    return view;
+}
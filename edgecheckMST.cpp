@@ -3,6 +3,12 @@
 #include <algorithm>
 #include <numeric>
 
+#include "dedup.h"
+#include "dsu.h"
+#include "edge_input.h"
+#include "fast_output.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 // Structure to represent an edge
@@ -11,63 +17,45 @@ struct Edge {
     int id; // To store original index
 };
 
-// Comparator to sort edges by weight
-bool compareEdges(const Edge& a, const Edge& b) {
-    return a.w < b.w;
-}
-
-// Disjoint Set Union (DSU) structure with Path Compression
-struct DSU {
-    vector<int> parent;
-    
-    DSU(int n) {
-        parent.resize(n + 1);
-        // Initialize parent of each node to itself
-        iota(parent.begin(), parent.end(), 0);
-    }
-    
-    // Find with path compression
-    int find(int i) {
-        if (parent[i] == i)
-            return i;
-        return parent[i] = find(parent[i]);
-    }
-    
-    // Union two sets
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-        }
-    }
-};
+// Per-edge answer, one byte per edge; names in the same order
+enum Answer : uint8_t { NO, YES };
+const ResultTable ANSWER_NAMES = {"NO", "YES"};
 
-int main() {
+int main(int argc, char** argv) {
     // Optimize I/O operations for speed
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n, m;
-    if (!(cin >> n >> m)) return 0;
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    int n;
+    vector<Edge> edges;
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, n, edges)) return 0;
+    int m = edges.size();
+    for (int i = 0; i < m; ++i) edges[i].id = i; // Store 0-based index
 
-    vector<Edge> edges(m);
-    for (int i = 0; i < m; ++i) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
-        edges[i].id = i; // Store 0-based index
+    // --dedup: only the lightest copies of a pair can be in an MST; keep one
+    // of them and answer for the others at the end (--stats prints the reduction)
+    DedupResult dedup;
+    bool dedup_on = has_flag(argc, argv, "--dedup");
+    if (dedup_on) {
+        dedup = dedup_edges(edges, [](const Edge& e) { return e.w; });
+        if (has_flag(argc, argv, "--stats")) print_dedup_stats(dedup.stats);
+        keep_edges(edges, dedup.kept);
     }
+    int count = edges.size();
 
     // Sort edges by weight
-    sort(edges.begin(), edges.end(), compareEdges);
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; });
 
     DSU dsu(n);
-    vector<string> results(m);
+    vector<uint8_t> results(m);
 
     int i = 0;
-    while (i < m) {
+    while (i < count) {
         int j = i;
         // Identify the range [i, j) of edges with the same weight
-        while (j < m && edges[j].w == edges[i].w) {
+        while (j < count && edges[j].w == edges[i].w) {
             j++;
         }
 
@@ -75,9 +63,9 @@ int main() {
         // We check against the graph formed ONLY by edges strictly smaller than the current weight
         for (int k = i; k < j; ++k) {
             if (dsu.find(edges[k].u) != dsu.find(edges[k].v)) {
-                results[edges[k].id] = "YES";
+                results[edges[k].id] = YES;
             } else {
-                results[edges[k].id] = "NO";
+                results[edges[k].id] = NO;
             }
         }
 
@@ -91,10 +79,19 @@ int main() {
         i = j;
     }
 
-    // Output results in the original input order
-    for (int k = 0; k < m; ++k) {
-        cout << results[k] << "\n";
+    // Dropped copies: a copy as light as the kept one answers the same,
+    // heavier copies and self-loops are never in an MST
+    if (dedup_on) {
+        for (int e = 0; e < m; ++e) {
+            uint32_t r = dedup.rep[e];
+            if (r != (uint32_t)e) results[e] = r < DEDUP_DOMINATED ? results[r] : static_cast<uint8_t>(NO);
+        }
     }
 
+    // Output results in the original input order
+    // (--binary-output writes the raw answer bytes instead)
+    FastOutput out;
+    write_results(out, results, ANSWER_NAMES, has_flag(argc, argv, "--binary-output"));
+
     return 0;
 }
\ No newline at end of file
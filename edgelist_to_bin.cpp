@@ -0,0 +1,73 @@
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+#include "cli.h"
+#include "fast_input.h"
+#include "graph_file.h"
+
+using namespace std;
+
+// Converts a text edge list ("n m" header, then m "u v w" lines) into the
+// binary graph format of graph_file.h, which the programs load with --graph=.
+//
+// Usage: edgelist_to_bin <output> [--weight=int|long|double] [--input=edges.txt] < edges.txt
+//
+// The output file is sized from the header and mapped, and the parallel
+// parser writes each edge straight into its column.
+
+template <typename W>
+bool convert(FastInput& in, GraphFileWriter& out, long long m) {
+    W* w = out.weights<W>();
+    bool ok = in.read_records<int32_t, int32_t, W>(m, [&](size_t i, int32_t u, int32_t v, W weight) {
+        out.u[i] = u;
+        out.v[i] = v;
+        w[i] = weight;
+    });
+    if (!ok) cerr << "expected " << m << " edges, input ended early\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        cerr << "usage: " << argv[0] << " <output> [--weight=int|long|double] < edges.txt\n";
+        return 1;
+    }
+    const char* output = argv[1];
+
+    const char* weight = flag_value(argc, argv, "--weight", "int");
+    WeightType type;
+    if (strcmp(weight, "int") == 0) type = WeightType::Int32;
+    else if (strcmp(weight, "long") == 0) type = WeightType::Int64;
+    else if (strcmp(weight, "double") == 0) type = WeightType::Float64;
+    else {
+        cerr << "unknown weight type '" << weight << "'\n";
+        return 1;
+    }
+
+    FastInput in(argc, argv);
+    long long n, m;
+    if (!in.read(n, m) || n < 0 || m < 0) {
+        cerr << "missing 'n m' header\n";
+        return 1;
+    }
+
+    GraphFileWriter out;
+    if (!out.create(output, n, m, type)) return 1;
+
+    bool ok = false;
+    switch (type) {
+        case WeightType::Int32: ok = convert<int32_t>(in, out, m); break;
+        case WeightType::Int64: ok = convert<int64_t>(in, out, m); break;
+        case WeightType::Float64: ok = convert<double>(in, out, m); break;
+    }
+    if (!ok) {
+        out.file.close();
+        remove(output);
+        return 1;
+    }
+
+    cerr << "wrote " << output << ": n = " << n << ", m = " << m << ", " << graph_file_size(out.header) << " bytes\n";
+    return 0;
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+
+#include "cli.h"
+#include "mmap_file.h"
+#include "parallel.h"
+
+// Fast text input shared by every program.
+//
+// The whole input is held in memory at once: stdin is slurped with large
+// read() calls on the first read, or with --input=path a file is mapped.
+// Nothing touches stdin before that, so a program whose graph comes from
+// --graph=path does not wait on a stdin it never reads. Numbers are parsed by
+// hand (integers eight digits at a time with SWAR, doubles with from_chars so
+// they round exactly like operator>>).
+//
+// Big blocks of fixed-size records (edge lists, query lists, grid heights)
+// go through read_records(), which splits the block into per-thread chunks at
+// whitespace, counts tokens per chunk, and then parses every chunk in
+// parallel straight into the caller's arrays. Tokens are counted, not lines,
+// so records do not have to be one per line.
+//
+// open_stream() is for programs that answer queries as they arrive: stdin is
+// then read as parsing needs it, a single value never waits for more than
+// the bytes that complete it, and a record block waits only for itself.
+
+namespace fast_input_detail {
+
+inline bool is_space(char c) {
+    return static_cast<unsigned char>(c) <= ' ';
+}
+
+inline bool is_digit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// True if the 8 bytes at p are all ASCII digits
+inline bool eight_digits(const char* p) {
+    uint64_t x;
+    std::memcpy(&x, p, 8);
+    return ((x & 0xF0F0F0F0F0F0F0F0ULL) | (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+// Value of 8 ASCII digits (little-endian load)
+inline uint32_t parse_eight_digits(const char* p) {
+    uint64_t x;
+    std::memcpy(&x, p, 8);
+    x = (x & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+    x = (x & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+    return static_cast<uint32_t>((x & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+}
+
+inline const char* skip_space(const char* p, const char* end) {
+    while (p < end && is_space(*p)) ++p;
+    return p;
+}
+
+// Parse one number at p (no leading whitespace); advances p past it
+template <typename T>
+T parse_number(const char*& p, const char* end) {
+    if constexpr (std::is_floating_point_v<T>) {
+        T value = 0;
+        if (p < end && *p == '+') ++p;
+        auto res = std::from_chars(p, end, value);
+        p = res.ptr;
+        while (p < end && !is_space(*p)) ++p; // Skip anything from_chars left behind
+        return value;
+    } else {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+        uint64_t value = 0;
+        while (end - p >= 8 && eight_digits(p)) {
+            value = value * 100000000 + parse_eight_digits(p);
+            p += 8;
+        }
+        while (p < end && is_digit(*p)) value = value * 10 + (*p++ - '0');
+        while (p < end && !is_space(*p)) ++p;
+        return static_cast<T>(negative ? 0 - value : value);
+    }
+}
+
+inline std::size_t count_tokens(const char* p, const char* end) {
+    std::size_t tokens = 0;
+    bool prev_space = true;
+    for (; p < end; ++p) {
+        bool space = is_space(*p);
+        tokens += prev_space & !space;
+        prev_space = space;
+    }
+    return tokens;
+}
+
+} // namespace fast_input_detail
+
+// Below this many tokens a record block is parsed on the calling thread
+const std::size_t FAST_INPUT_PARALLEL_TOKENS = 1 << 18;
+
+struct FastInput {
+    MappedFile mapped;
+    std::vector<char> owned;
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    bool streaming = false; // Set by open_stream(): owned is a window, topped up by refill()
+    bool at_eof = false;
+    bool stdin_pending = false; // Set by open(): stdin is read on the first request
+
+    FastInput() = default;
+    FastInput(int argc, char** argv) { open(argc, argv); }
+
+    // --input=path maps the file; otherwise all of stdin is read, once
+    // something is read
+    bool open(int argc, char** argv) {
+        if (const char* path = flag_value(argc, argv, "--input")) {
+            if (!mapped.open_read(path)) return false;
+            pos = mapped.data;
+            end = mapped.data + mapped.size;
+            return true;
+        }
+        stdin_pending = true;
+        return true;
+    }
+
+    // Like open(), but stdin is read incrementally (--input=path still maps)
+    bool open_stream(int argc, char** argv) {
+        if (flag_value(argc, argv, "--input")) return open(argc, argv);
+        streaming = true;
+        stdin_pending = false;
+        at_eof = false;
+        owned.assign(1 << 16, 0);
+        pos = end = owned.data();
+        return true;
+    }
+
+    // True if a whole token is already buffered, i.e. the next read() will
+    // not block
+    bool has_buffered_token() {
+        load_stdin();
+        const char* p = fast_input_detail::skip_space(pos, end);
+        return p != end && (!streaming || at_eof || to_boundary(p) != end);
+    }
+
+    bool read_all(int fd) {
+        stdin_pending = false;
+        owned.clear();
+        std::size_t used = 0;
+        owned.resize(1 << 20);
+        while (true) {
+            if (used == owned.size()) owned.resize(owned.size() * 2);
+            ssize_t got = ::read(fd, owned.data() + used, owned.size() - used);
+            if (got <= 0) break;
+            used += static_cast<std::size_t>(got);
+        }
+        owned.resize(used);
+        pos = owned.data();
+        end = owned.data() + used;
+        return true;
+    }
+
+    // Read one value per argument, like "cin >> a >> b"; false if input runs out
+    template <typename... T>
+    bool read(T&... values) {
+        return (read_one(values) && ...);
+    }
+
+    template <typename T>
+    bool read_one(T& value) {
+        load_stdin();
+        pos = fast_input_detail::skip_space(pos, end);
+        // A streamed token is only complete once whitespace (or EOF) follows it
+        while (streaming && (pos == end || to_boundary(pos) == end) && refill()) {
+            pos = fast_input_detail::skip_space(pos, end);
+        }
+        if (pos == end) return false;
+        value = fast_input_detail::parse_number<T>(pos, end);
+        return true;
+    }
+
+    // Read count records of sizeof...(T) numbers each and call
+    // sink(i, field0, field1, ...) once per record. For large blocks sink is
+    // called from several threads at once (each i exactly once), so it must
+    // only write to slot i. Returns false if the input runs out.
+    template <typename... T, typename Sink>
+    bool read_records(std::size_t count, Sink sink, unsigned num_threads = 0) {
+        constexpr std::size_t K = sizeof...(T);
+        const std::size_t needed = count * K;
+        unsigned threads = resolve_thread_count(needed, num_threads, FAST_INPUT_PARALLEL_TOKENS);
+        load_stdin();
+        if (streaming) buffer_tokens(needed);
+
+        if (threads <= 1) {
+            for (std::size_t i = 0; i < count; i++) {
+                std::tuple<T...> rec;
+                if (!std::apply([&](auto&... f) { return read(f...); }, rec)) return false;
+                std::apply([&](auto&... f) { sink(i, f...); }, rec);
+            }
+            return true;
+        }
+        return read_records_parallel<T...>(count, sink, threads);
+    }
+
+private:
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        std::size_t tokens;
+        std::size_t first_token;
+    };
+
+    void load_stdin() {
+        if (stdin_pending) read_all(0);
+    }
+
+    // Streaming: keep the unread bytes and append whatever read() returns;
+    // false at EOF
+    bool refill() {
+        if (!streaming || at_eof) return false;
+        std::size_t left = end - pos;
+        if (pos != owned.data()) std::memmove(owned.data(), pos, left);
+        if (left == owned.size()) owned.resize(owned.size() * 2);
+        ssize_t got = ::read(0, owned.data() + left, owned.size() - left);
+        if (got <= 0) {
+            at_eof = true;
+            got = 0;
+        }
+        pos = owned.data();
+        end = pos + left + got;
+        return got > 0;
+    }
+
+    // Streaming: read until the next needed tokens are all buffered and
+    // complete (or the input ends)
+    void buffer_tokens(std::size_t needed) {
+        std::size_t tokens = 0, scanned = 0; // Counted so far, up to pos + scanned
+        while (true) {
+            const char* from = pos + scanned;
+            const char* stop = end;
+            if (!at_eof) {
+                while (stop > from && !fast_input_detail::is_space(stop[-1])) --stop;
+            }
+            tokens += fast_input_detail::count_tokens(from, stop);
+            scanned = stop - pos;
+            if (tokens >= needed || !refill()) break;
+        }
+    }
+
+    // Move p forward to the next whitespace so no token is split
+    const char* to_boundary(const char* p) const {
+        while (p < end && !fast_input_detail::is_space(*p)) ++p;
+        return p;
+    }
+
+    template <typename... T, typename Sink>
+    bool read_records_parallel(std::size_t count, Sink sink, unsigned threads) {
+        using namespace fast_input_detail;
+        constexpr std::size_t K = sizeof...(T);
+        const std::size_t needed = count * K;
+
+        // Pass 1: count tokens per chunk. Each token takes at least 2 bytes,
+        // so start with that much input and double until the block is covered.
+        std::vector<Chunk> chunks;
+        std::size_t total = 0;
+        const char* scanned = pos;
+        std::size_t window = 2 * needed;
+        while (total < needed && scanned < end) {
+            const char* stop = to_boundary(scanned + std::min<std::size_t>(window, end - scanned));
+            std::size_t first = chunks.size();
+            std::size_t bytes = stop - scanned;
+            for (unsigned t = 0; t < threads; t++) {
+                const char* b = t == 0 ? scanned : to_boundary(scanned + chunk_begin(bytes, threads, t));
+                const char* e = t + 1 == threads ? stop : to_boundary(scanned + chunk_begin(bytes, threads, t + 1));
+                if (b < e) chunks.push_back({b, e, 0, 0});
+            }
+            parallel_chunks(chunks.size() - first, threads, [&](unsigned, std::size_t b, std::size_t e) {
+                for (std::size_t c = first + b; c < first + e; c++) {
+                    chunks[c].tokens = count_tokens(chunks[c].begin, chunks[c].end);
+                }
+            });
+            for (std::size_t c = first; c < chunks.size(); c++) {
+                chunks[c].first_token = total;
+                total += chunks[c].tokens;
+            }
+            scanned = stop;
+            window *= 2;
+        }
+        if (total < needed) return false;
+
+        // Pass 2: every chunk parses the records that start inside it
+        const char* block_end = nullptr;
+        parallel_chunks(chunks.size(), threads, [&](unsigned, std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; c++) {
+                const Chunk& ch = chunks[c];
+                if (ch.first_token >= needed) break;
+                const char* p = ch.begin;
+                std::size_t token = ch.first_token;
+                // Tokens of a record that began in the previous chunk
+                for (std::size_t skip = (K - token % K) % K; skip > 0 && token < ch.first_token + ch.tokens; skip--) {
+                    p = skip_space(p, end);
+                    p = to_boundary(p);
+                    token++;
+                }
+                while (token < ch.first_token + ch.tokens && token < needed) {
+                    std::size_t i = token / K;
+                    std::tuple<T...> rec{parse_field<T>(p)...};
+                    std::apply([&](auto&... f) { sink(i, f...); }, rec);
+                    token += K;
+                    if (i + 1 == count) block_end = p;
+                }
+            }
+        });
+
+        pos = block_end;
+        return true;
+    }
+
+    template <typename T>
+    T parse_field(const char*& p) const {
+        p = fast_input_detail::skip_space(p, end);
+        return fast_input_detail::parse_number<T>(p, end);
+    }
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// Buffered output shared by the programs that print one line per edge or per
+// query. Everything is appended to one large buffer that goes to write(2) in
+// big blocks: no per-line flushes and no allocation per item.
+struct FastOutput {
+    std::vector<char> buf;
+    std::size_t used = 0;
+    int fd;
+
+    explicit FastOutput(int fd = 1, std::size_t capacity = 1 << 22) : buf(capacity), fd(fd) {}
+    FastOutput(const FastOutput&) = delete;
+    FastOutput& operator=(const FastOutput&) = delete;
+    ~FastOutput() { flush(); }
+
+    void flush() {
+        std::size_t done = 0;
+        while (done < used) {
+            ssize_t wrote = ::write(fd, buf.data() + done, used - done);
+            if (wrote <= 0) break;
+            done += static_cast<std::size_t>(wrote);
+        }
+        used = 0;
+    }
+
+    // Make sure len more bytes fit in the buffer
+    char* space(std::size_t len) {
+        if (used + len > buf.size()) {
+            flush();
+            if (len > buf.size()) buf.resize(len);
+        }
+        return buf.data() + used;
+    }
+
+    void write(const char* s, std::size_t len) {
+        std::memcpy(space(len), s, len);
+        used += len;
+    }
+
+    void write(const std::string& s) { write(s.data(), s.size()); }
+
+    void put(char c) {
+        *space(1) = c;
+        used++;
+    }
+
+    template <typename T>
+    void write_int(T value) {
+        char* p = space(24);
+        used = std::to_chars(p, p + 24, value).ptr - buf.data();
+    }
+};
+
+// Fixed result strings indexed by a one-byte code. Each entry is stored with
+// its trailing newline so emitting a result is a single memcpy.
+struct ResultTable {
+    std::vector<std::string> lines;
+
+    ResultTable(std::initializer_list<const char*> names) {
+        for (const char* name : names) lines.push_back(std::string(name) + "\n");
+    }
+};
+
+// Emit one result: its line of text, or with binary set the raw code byte
+inline void write_result(FastOutput& out, uint8_t code, const ResultTable& table, bool binary) {
+    if (binary) out.put(static_cast<char>(code));
+    else out.write(table.lines[code]);
+}
+
+// Emit one line per code, or with binary set the raw code bytes (one byte per
+// result, same order) for downstream tools
+inline void write_results(FastOutput& out, const std::vector<uint8_t>& codes, const ResultTable& table, bool binary) {
+    if (binary) {
+        out.write(reinterpret_cast<const char*>(codes.data()), codes.size());
+        return;
+    }
+    for (uint8_t code : codes) out.write(table.lines[code]);
+}
@@ -3,6 +3,12 @@
 #include <algorithm>
 #include <numeric>
 
+#include "cli.h"
+#include "dedup.h"
+#include "dsu.h"
+#include "fast_input.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 // Structure to represent a friendship (edge)
@@ -11,50 +17,24 @@ struct Edge {
     long long w; // Strength S
 };
 
-// Comparator: Sort descending to prioritize strongest edges
-bool compareEdges(const Edge& a, const Edge& b) {
-    return a.w > b.w; // Descending order
-}
-
-struct DSU {
-    vector<int> parent;
-    int num_components; // Track number of clusters
-
-    DSU(int n) {
-        parent.resize(n + 1);
-        num_components = n; // Initially N disjoint people
-        iota(parent.begin(), parent.end(), 0);
-    }
-
-    int find(int i) {
-        if (parent[i] == i)
-            return i;
-        return parent[i] = find(parent[i]);
-    }
-
-    bool unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-            num_components--; // 1 merge = 1 less component
-            return true;
-        }
-        return false;
-    }
-};
-
-void solve() {
+void solve(FastInput& in, bool dedup, bool show_stats) {
     int N, M, K;
-    if (!(cin >> N >> M >> K)) return;
+    if (!in.read(N, M, K)) return;
 
     vector<Edge> edges(M);
-    for (int i = 0; i < M; ++i) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
+    in.read_records<int, int, long long>(M, [&](size_t i, int u, int v, long long w) {
+        edges[i] = {u, v, w};
+    });
+
+    // Maximum spanning logic only ever uses the strongest copy of a pair
+    if (dedup) {
+        DedupResult d = dedup_edges(edges, [](const Edge& e) { return e.w; }, true);
+        if (show_stats) print_dedup_stats(d.stats);
+        keep_edges(edges, d.kept);
     }
 
     // Step 1: Sort descending (Maximum Spanning logic)
-    sort(edges.begin(), edges.end(), compareEdges);
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; }, true);
 
     DSU dsu(N);
     long long total_strength = 0;
@@ -74,15 +54,17 @@ void solve() {
     if (dsu.num_components > K) {
         // This happens if the graph was too disconnected to begin with
         // (e.g., requested 2 clusters but graph has 5 isolated islands)
-        cout << "-1" << endl; 
+        cout << "-1\n"; 
     } else {
-        cout << total_strength << endl;
+        cout << total_strength << "\n";
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
-    solve();
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    // --dedup drops self-loops and weaker parallel edges (--stats prints the reduction)
+    solve(in, has_flag(argc, argv, "--dedup"), has_flag(argc, argv, "--stats"));
     return 0;
 }
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+#include "mmap_file.h"
+
+// Binary edge-list format (.mstg), read with a single mmap and no parsing.
+//
+//   offset 0   GraphFileHeader (64 bytes)
+//   u_offset   m x int32   first endpoints
+//   v_offset   m x int32   second endpoints
+//   w_offset   m x weight  int32, int64 or float64 as given by weight_type
+//
+// Every column starts on a 64-byte boundary, after the previous one ends.
+// Values are stored in native (little-endian) byte order; the magic string
+// rejects anything else. open() checks the header against all of this, so
+// a damaged file fails there instead of in the callers, but the endpoints
+// themselves are not scanned.
+
+enum class WeightType : uint32_t { Int32 = 0, Int64 = 1, Float64 = 2 };
+
+inline std::size_t weight_size(WeightType t) {
+    return t == WeightType::Int32 ? 4 : 8;
+}
+
+// True if a weight column of type t can be used as W in place
+template <typename W>
+bool weight_type_is(WeightType t) {
+    if (std::is_floating_point<W>::value) return t == WeightType::Float64 && sizeof(W) == 8;
+    if (!std::is_signed<W>::value) return false;
+    return (t == WeightType::Int32 && sizeof(W) == 4) || (t == WeightType::Int64 && sizeof(W) == 8);
+}
+
+const char GRAPH_FILE_MAGIC[8] = {'M', 'S', 'T', 'G', 'R', 'P', 'H', '1'};
+const uint32_t GRAPH_FILE_VERSION = 1;
+
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    WeightType weight_type;
+    uint64_t n;
+    uint64_t m;
+    uint64_t u_offset;
+    uint64_t v_offset;
+    uint64_t w_offset;
+    uint64_t reserved;
+};
+static_assert(sizeof(GraphFileHeader) == 64, "header must stay 64 bytes");
+
+inline uint64_t align_up(uint64_t x, uint64_t a = 64) {
+    return (x + a - 1) / a * a;
+}
+
+// Header for a graph with the given shape, column offsets filled in
+inline GraphFileHeader make_graph_header(uint64_t n, uint64_t m, WeightType type) {
+    GraphFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic));
+    h.version = GRAPH_FILE_VERSION;
+    h.weight_type = type;
+    h.n = n;
+    h.m = m;
+    h.u_offset = align_up(sizeof(GraphFileHeader));
+    h.v_offset = align_up(h.u_offset + 4 * m);
+    h.w_offset = align_up(h.v_offset + 4 * m);
+    return h;
+}
+
+inline uint64_t graph_file_size(const GraphFileHeader& h) {
+    return h.w_offset + weight_size(h.weight_type) * h.m;
+}
+
+// Read-only view of a mapped graph file. The columns point straight into the
+// mapping; nothing is copied.
+struct GraphFile {
+    MappedFile file;
+    const GraphFileHeader* header = nullptr;
+    const int32_t* u = nullptr;
+    const int32_t* v = nullptr;
+    const void* w = nullptr;
+
+    bool open(const char* path) {
+        if (!file.open_read(path)) return false;
+        if (file.size < sizeof(GraphFileHeader)) return bad(path, "too small");
+        header = reinterpret_cast<const GraphFileHeader*>(file.data);
+        if (std::memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0) return bad(path, "not a graph file");
+        if (header->version != GRAPH_FILE_VERSION) return bad(path, "unsupported version");
+        if (header->weight_type > WeightType::Float64) return bad(path, "unknown weight type");
+        if (header->n >= static_cast<uint64_t>(INT_MAX)) return bad(path, "too many nodes");
+        if (header->u_offset < sizeof(GraphFileHeader)) return bad(path, "columns overlap the header");
+        if (!column_fits(header->u_offset, 4, header->v_offset) || !column_fits(header->v_offset, 4, header->w_offset)) {
+            return bad(path, "columns misaligned or overlapping");
+        }
+        if (!column_fits(header->w_offset, weight_size(header->weight_type), file.size)) return bad(path, "truncated");
+        u = reinterpret_cast<const int32_t*>(file.data + header->u_offset);
+        v = reinterpret_cast<const int32_t*>(file.data + header->v_offset);
+        w = file.data + header->w_offset;
+        return true;
+    }
+
+    // Unmap; the column pointers are invalid afterwards
+    void close() {
+        file.close();
+        header = nullptr;
+        u = v = nullptr;
+        w = nullptr;
+    }
+
+    uint64_t n() const { return header->n; }
+    uint64_t m() const { return header->m; }
+    WeightType weight_type() const { return header->weight_type; }
+
+    // Typed column access; T must match weight_type()
+    template <typename T>
+    const T* weights() const { return static_cast<const T*>(w); }
+
+    // Weight i converted to T, whatever the stored type
+    template <typename T>
+    T weight_as(std::size_t i) const {
+        switch (header->weight_type) {
+            case WeightType::Int32: return static_cast<T>(weights<int32_t>()[i]);
+            case WeightType::Int64: return static_cast<T>(weights<int64_t>()[i]);
+            case WeightType::Float64: return static_cast<T>(weights<double>()[i]);
+        }
+        return T();
+    }
+
+private:
+    // A column of m values of the given size at offset is 64-byte aligned
+    // and ends by limit (without overflowing)
+    bool column_fits(uint64_t offset, uint64_t size, uint64_t limit) const {
+        if (offset % 64 != 0 || offset > limit) return false;
+        return header->m <= (limit - offset) / size;
+    }
+
+    bool bad(const char* path, const char* why) {
+        std::cerr << "'" << path << "': " << why << "\n";
+        file.close();
+        header = nullptr;
+        return false;
+    }
+};
+
+// Writable graph file: create() sizes and maps the file, the caller fills the
+// columns in place, and the destructor flushes it
+struct GraphFileWriter {
+    MappedFile file;
+    GraphFileHeader header;
+    int32_t* u = nullptr;
+    int32_t* v = nullptr;
+    char* w = nullptr;
+
+    bool create(const char* path, uint64_t n, uint64_t m, WeightType type) {
+        header = make_graph_header(n, m, type);
+        if (!file.create(path, graph_file_size(header))) return false;
+        std::memcpy(file.data, &header, sizeof(header));
+        u = reinterpret_cast<int32_t*>(file.data + header.u_offset);
+        v = reinterpret_cast<int32_t*>(file.data + header.v_offset);
+        w = file.data + header.w_offset;
+        return true;
+    }
+
+    template <typename T>
+    T* weights() { return reinterpret_cast<T*>(w); }
+};
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <numeric>
 
+#include "dsu.h"
+#include "fast_input.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 // Structure to represent an edge in the grid
@@ -12,55 +16,21 @@ struct Edge {
     int w;    // Weight: |Height[u] - Height[v]|
 };
 
-// Comparator for sorting edges
-bool compareEdges(const Edge& a, const Edge& b) {
-    return a.w < b.w;
-}
-
-// Disjoint Set Union (DSU) structure
-struct DSU {
-    vector<int> parent;
-    int num_components; // Track number of disjoint sets
-
-    DSU(int n) {
-        parent.resize(n);
-        iota(parent.begin(), parent.end(), 0);
-        num_components = n; // Initially, every node is its own component
-    }
-
-    int find(int i) {
-        if (parent[i] == i)
-            return i;
-        return parent[i] = find(parent[i]);
-    }
-
-    bool unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-            num_components--; // Two components merged into one
-            return true;
-        }
-        return false;
-    }
-};
-
-int main() {
+int main(int argc, char** argv) {
     // Optimization for faster I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+
     int R, C;
     long long K; // K can be large, use long long for cost calculations
-    if (!(cin >> R >> C >> K)) return 0;
+    if (!in.read(R, C, K)) return 0;
 
     // Use a 1D vector to store the grid for easier indexing
     // Index = r * C + c
     vector<int> heights(R * C);
-    for (int i = 0; i < R * C; ++i) {
-        cin >> heights[i];
-    }
+    in.read_records<int>(R * C, [&](size_t i, int h) { heights[i] = h; });
 
     vector<Edge> edges;
     edges.reserve(2 * R * C); // Reserve memory to avoid reallocations
@@ -98,7 +68,7 @@ int main() {
     }
 
     // Step 2: Sort valid grid edges
-    sort(edges.begin(), edges.end(), compareEdges);
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; });
 
     // Step 3: Kruskal's Algorithm
     DSU dsu(R * C);
@@ -119,7 +89,7 @@ int main() {
     long long teleporters_needed = dsu.num_components - 1;
     total_cost += teleporters_needed * K;
 
-    cout << total_cost << endl;
+    cout << total_cost << "\n";
 
     return 0;
 }
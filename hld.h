@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "csr.h"
+
+// Heavy-light decomposition of a forest with a max sparse table, for
+// maximum-weight-on-path queries.
+//
+// Every node continues the chain of its parent if it has the largest
+// subtree among its siblings, so any root path crosses O(log n) chains, and
+// on typical trees only one or two. Chains get consecutive positions, each
+// node's position holding the weight of the edge to its parent, so the part
+// of a path inside one chain is one range-max lookup in a sparse table: a
+// query is O(log n) O(1) lookups in the worst case. Everything a query
+// touches is indexed by position, so after the first lookup the walk stays
+// inside these arrays. Construction is BFS based, without recursion.
+//
+// Usage:
+//   HeavyLight<int> hld;
+//   hld.build(n, tree_adj);                      // CSRGraph<int> over nodes 0..n, arc data = weight
+//   if (hld.connected(u, v)) w = hld.path_max(u, v);
+
+template <typename W>
+struct HeavyLight {
+    static constexpr W NONE = std::numeric_limits<W>::lowest(); // Max of an empty path
+
+    int n = 0;
+    std::vector<int32_t> pos_of; // Node -> position (1..n)
+    // By position:
+    std::vector<int32_t> top;   // Position of the chain's first node
+    std::vector<int32_t> above; // Position of the parent (0 for a root)
+    std::vector<int32_t> depth;
+    std::vector<int32_t> root; // Position of the tree's root
+    std::vector<std::vector<W>> table; // table[k][p] = max weight of positions p .. p + 2^k - 1
+
+    // tree: the forest over nodes 1..n (node 0 unused)
+    template <typename Data>
+    void build(int num_nodes, const CSRGraph<Data>& tree) {
+        n = num_nodes;
+
+        // 1. BFS every tree for parents, depths and the edge weights to parents
+        std::vector<int32_t> order, parent(n + 1, 0), node_depth(n + 1, 0);
+        std::vector<W> weight(n + 1, NONE);
+        std::vector<uint8_t> seen(n + 1, 0);
+        order.reserve(n);
+        for (int s = 1; s <= n; s++) {
+            if (seen[s]) continue;
+            seen[s] = 1;
+            order.push_back(s);
+            for (std::size_t head = order.size() - 1; head < order.size(); head++) {
+                int32_t x = order[head];
+                for (uint32_t a = tree.begin(x); a < tree.end(x); a++) {
+                    int32_t y = tree.target[a];
+                    if (seen[y]) continue;
+                    seen[y] = 1;
+                    parent[y] = x;
+                    node_depth[y] = node_depth[x] + 1;
+                    weight[y] = tree.data[a];
+                    order.push_back(y);
+                }
+            }
+        }
+
+        // 2. Subtree sizes bottom-up, and the heavy child of every node
+        std::vector<int32_t> size(n + 1, 1), heavy(n + 1, 0);
+        for (std::size_t i = order.size(); i-- > 0;) {
+            int32_t x = order[i], p = parent[x];
+            if (!p) continue;
+            size[p] += size[x];
+            if (!heavy[p] || size[heavy[p]] < size[x]) heavy[p] = x;
+        }
+
+        // 3. Chains in BFS order of their first node, each laid out in full
+        pos_of.assign(n + 1, 0);
+        top.assign(n + 1, 0);
+        above.assign(n + 1, 0);
+        depth.assign(n + 1, 0);
+        root.assign(n + 1, 0);
+        std::vector<W> by_pos(n + 1, NONE);
+        int32_t next = 1;
+        for (int32_t x : order) {
+            if (parent[x] && heavy[parent[x]] == x) continue; // Inside a chain
+            int32_t first = next;
+            for (int32_t y = x; y; y = heavy[y]) {
+                int32_t p = next++;
+                pos_of[y] = p;
+                top[p] = first;
+                above[p] = parent[y] ? pos_of[parent[y]] : 0;
+                depth[p] = node_depth[y];
+                root[p] = parent[y] ? root[pos_of[parent[y]]] : p;
+                by_pos[p] = weight[y];
+            }
+        }
+
+        // 4. Sparse table over the weights by position
+        table.assign(1, std::move(by_pos));
+        for (std::size_t len = 2; len <= table[0].size(); len *= 2) {
+            const std::vector<W>& prev = table.back();
+            std::vector<W> level(table[0].size() - len + 1);
+            for (std::size_t i = 0; i < level.size(); i++) {
+                level[i] = prev[i] < prev[i + len / 2] ? prev[i + len / 2] : prev[i];
+            }
+            table.push_back(std::move(level));
+        }
+    }
+
+    bool connected(int u, int v) const { return root[pos_of[u]] == root[pos_of[v]]; }
+
+    // Max weight over positions l .. r (l <= r)
+    W range_max(int32_t l, int32_t r) const {
+        int k = 31 - __builtin_clz(static_cast<unsigned>(r - l + 1));
+        const W& a = table[k][l];
+        const W& b = table[k][r - (1 << k) + 1];
+        return a < b ? b : a;
+    }
+
+    // Heaviest edge on the path between connected nodes u and v (NONE if u == v)
+    W path_max(int u, int v) const {
+        int32_t a = pos_of[u], b = pos_of[v];
+        W res = NONE;
+        auto take = [&res](const W& w) {
+            if (res < w) res = w;
+        };
+
+        // Climb from the chain whose first node is deeper until both share one
+        while (top[a] != top[b]) {
+            if (depth[top[a]] < depth[top[b]]) std::swap(a, b);
+            take(range_max(top[a], a));
+            a = above[top[a]];
+        }
+        // Same chain: the edges below the shallower node
+        if (a != b) {
+            if (a > b) std::swap(a, b);
+            take(range_max(a + 1, b));
+        }
+        return res;
+    }
+};
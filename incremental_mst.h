@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "link_cut_tree.h"
+
+// Minimum spanning forest under edge insertions, with path-max queries, all
+// O(log n) amortized.
+//
+// The forest lives in a link-cut tree: one node per vertex and one per tree
+// edge, carrying its weight. A new edge (u, v, w) between two trees is
+// linked; inside a tree it replaces the heaviest edge on the u-v path if
+// that one is strictly heavier, and is dropped otherwise. Nothing is kept
+// for dropped or replaced edges, so memory stays O(n) however long the
+// stream is. The heaviest edge on a path is the same for every minimum
+// spanning forest, so answers match a rebuild from scratch.
+//
+// Usage:
+//   IncrementalMST<int> mst(n);           // Nodes 1..n, no edges
+//   mst.insert(u, v, w);
+//   if (mst.connected(u, v)) w = mst.path_max(u, v);   // u != v
+
+template <typename W>
+struct IncrementalMST {
+    // Link-cut key of an edge node; vertex nodes get the lowest possible key
+    struct Key {
+        W w;
+        int32_t node;
+        bool operator<(const Key& o) const { return w < o.w || (w == o.w && node < o.node); }
+    };
+
+    int n = 0;
+    LinkCutTree<Key> lct;
+    std::vector<int32_t> end_u, end_v; // Edge node - (n + 1) -> endpoints
+    std::vector<int32_t> free_nodes;   // Edge nodes of replaced edges, for reuse
+    long long weight = 0;              // Total weight of the forest
+
+    explicit IncrementalMST(int num_nodes = 0) { reset(num_nodes); }
+
+    void reset(int num_nodes) {
+        n = num_nodes;
+        lct = LinkCutTree<Key>(n + 1, Key{std::numeric_limits<W>::lowest(), -1});
+        end_u.clear();
+        end_v.clear();
+        free_nodes.clear();
+        weight = 0;
+    }
+
+    // Returns true if the edge joined the forest
+    bool insert(int u, int v, W w) {
+        if (u == v) return false;
+        if (lct.connected(u, v)) {
+            Key heaviest = lct.path_max(u, v);
+            if (!(w < heaviest.w)) return false;
+            int e = heaviest.node;
+            lct.cut(end_u[e - n - 1], e);
+            lct.cut(e, end_v[e - n - 1]);
+            free_nodes.push_back(e);
+            weight -= heaviest.w;
+        }
+        link(u, v, w);
+        return true;
+    }
+
+    bool connected(int u, int v) { return lct.connected(u, v); }
+
+    // Heaviest forest edge on the path between connected nodes u != v
+    W path_max(int u, int v) { return lct.path_max(u, v).w; }
+
+private:
+    void link(int u, int v, W w) {
+        int e;
+        if (free_nodes.empty()) {
+            e = lct.add_node(Key{w, static_cast<int32_t>(lct.size())});
+            end_u.push_back(u);
+            end_v.push_back(v);
+        } else {
+            e = free_nodes.back();
+            free_nodes.pop_back();
+            lct.reset_node(e, Key{w, e});
+            end_u[e - n - 1] = u;
+            end_v[e - n - 1] = v;
+        }
+        lct.link(u, e);
+        lct.link(e, v);
+        weight += w;
+    }
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+#include "binary_lifting.h"
+#include "graph_file.h"
+#include "mmap_file.h"
+
+// Binary snapshot of a built path-max index (.msti), so a restarted query job
+// maps it read-only instead of re-reading the graph, sorting, running Kruskal
+// and rebuilding the tables. Only the binary-lifting index is stored.
+//
+//   offset 0         IndexFileHeader (128 bytes)
+//   index_of_offset  (n + 1) x int32   node -> BFS number
+//   depth_offset     (n + 1) x int32   by BFS number
+//   root_offset      (n + 1) x int32   by BFS number
+//   table_offset     levels * (n + 1) x (int32 ancestor, weight) entries
+//
+// Sections start on 64-byte boundaries, in native byte order like the graph
+// file. The checksum covers every byte after the header and is checked on
+// open, which also pages the file in.
+
+const char INDEX_FILE_MAGIC[8] = {'M', 'S', 'T', 'I', 'N', 'D', 'X', '1'};
+const uint32_t INDEX_FILE_VERSION = 1;
+
+struct IndexFileHeader {
+    char magic[8];
+    uint32_t version;
+    WeightType weight_type;
+    uint32_t layout; // LiftLayout
+    uint32_t levels;
+    uint64_t n;
+    uint64_t index_of_offset;
+    uint64_t depth_offset;
+    uint64_t root_offset;
+    uint64_t table_offset;
+    uint64_t checksum;
+    uint64_t reserved[7];
+};
+static_assert(sizeof(IndexFileHeader) == 128, "header must stay 128 bytes");
+
+template <typename W>
+WeightType weight_type_of() {
+    if (std::is_same<W, int32_t>::value) return WeightType::Int32;
+    if (std::is_same<W, int64_t>::value) return WeightType::Int64;
+    return WeightType::Float64;
+}
+
+// 64-bit hash of a byte range, one multiply per 8 bytes
+inline uint64_t checksum_bytes(const char* p, std::size_t len) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ len;
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t x;
+        std::memcpy(&x, p + i, 8);
+        h = (h ^ x) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+    for (; i < len; i++) h = (h ^ static_cast<unsigned char>(p[i])) * 0x100000001B3ULL;
+    return h;
+}
+
+template <typename W, LiftLayout Layout>
+bool save_index(const char* path, const BinaryLifting<W, Layout>& lift) {
+    using Entry = typename BinaryLifting<W, Layout>::Entry;
+    const uint64_t nodes = static_cast<uint64_t>(lift.n) + 1;
+
+    IndexFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, INDEX_FILE_MAGIC, sizeof(h.magic));
+    h.version = INDEX_FILE_VERSION;
+    h.weight_type = weight_type_of<W>();
+    h.layout = static_cast<uint32_t>(Layout);
+    h.levels = static_cast<uint32_t>(lift.levels);
+    h.n = static_cast<uint64_t>(lift.n);
+    h.index_of_offset = align_up(sizeof(IndexFileHeader));
+    h.depth_offset = align_up(h.index_of_offset + 4 * nodes);
+    h.root_offset = align_up(h.depth_offset + 4 * nodes);
+    h.table_offset = align_up(h.root_offset + 4 * nodes);
+    const uint64_t size = h.table_offset + sizeof(Entry) * lift.table_size();
+
+    MappedFile file;
+    if (!file.create(path, size)) return false;
+    std::memcpy(file.data + h.index_of_offset, lift.index_of, 4 * nodes);
+    std::memcpy(file.data + h.depth_offset, lift.depth, 4 * nodes);
+    std::memcpy(file.data + h.root_offset, lift.root, 4 * nodes);
+    std::memcpy(file.data + h.table_offset, lift.table, sizeof(Entry) * lift.table_size());
+    h.checksum = checksum_bytes(file.data + sizeof(h), size - sizeof(h));
+    std::memcpy(file.data, &h, sizeof(h));
+    return true;
+}
+
+// Read-only mapped snapshot; attach() points a BinaryLifting at its tables
+struct IndexFile {
+    MappedFile file;
+    const IndexFileHeader* header = nullptr;
+
+    bool open(const char* path) {
+        if (!file.open_read(path)) return false;
+        if (file.size < sizeof(IndexFileHeader)) return bad(path, "too small");
+        header = reinterpret_cast<const IndexFileHeader*>(file.data);
+        if (std::memcmp(header->magic, INDEX_FILE_MAGIC, sizeof(header->magic)) != 0) return bad(path, "not an index file");
+        if (header->version != INDEX_FILE_VERSION) return bad(path, "unsupported version");
+        if (file.size < header->table_offset) return bad(path, "truncated");
+        if (checksum_bytes(file.data + sizeof(IndexFileHeader), file.size - sizeof(IndexFileHeader)) != header->checksum) {
+            return bad(path, "checksum mismatch");
+        }
+        return true;
+    }
+
+    template <typename W, LiftLayout Layout>
+    bool attach(const char* path, BinaryLifting<W, Layout>& lift) {
+        using Entry = typename BinaryLifting<W, Layout>::Entry;
+        const IndexFileHeader& h = *header;
+        if (h.weight_type != weight_type_of<W>() || h.layout != static_cast<uint32_t>(Layout)) {
+            return bad(path, "built for another weight type or layout");
+        }
+        const uint64_t column = 4 * (h.n + 1);
+        if (h.index_of_offset + column > h.table_offset || h.depth_offset + column > h.table_offset ||
+            h.root_offset + column > h.table_offset ||
+            file.size != h.table_offset + sizeof(Entry) * h.levels * (h.n + 1)) {
+            return bad(path, "inconsistent section layout");
+        }
+        lift.attach(static_cast<int>(h.n), static_cast<int>(h.levels),
+                    reinterpret_cast<const int32_t*>(file.data + h.index_of_offset),
+                    reinterpret_cast<const int32_t*>(file.data + h.depth_offset),
+                    reinterpret_cast<const int32_t*>(file.data + h.root_offset),
+                    reinterpret_cast<const Entry*>(file.data + h.table_offset));
+        return true;
+    }
+
+private:
+    bool bad(const char* path, const char* why) {
+        std::cerr << "'" << path << "': " << why << "\n";
+        file.close();
+        header = nullptr;
+        return false;
+    }
+};
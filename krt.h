@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "dsu.h"
+
+// Kruskal reconstruction tree with O(1) path-maximum queries.
+//
+// Replaying the MST edges in Kruskal order, every union creates an internal
+// node carrying the merge weight, with the two merged components as
+// children; the original nodes are the leaves. The heaviest edge on the MST
+// path between u and v is the weight of LCA(u, v) in this tree.
+//
+// Merge weights never decrease towards the root, so the LCA is also the
+// heaviest node between u and v in the tree's Euler tour. We keep the compact
+// form of that tour, the in-order sequence (leaf, internal, leaf, ...,
+// leaf), and a max sparse table over its internal weights: one query is two
+// table lookups. Preprocessing is O(N log N) time and memory; there is no
+// recursion anywhere, so millions of nodes are fine.
+//
+// Usage:
+//   KruskalTree<int> krt;
+//   krt.build(n, tree.size(), [&](size_t k) { return edges[tree[k]]; });  // Kruskal order
+//   if (krt.connected(u, v)) w = krt.path_max(u, v);                      // u != v
+
+template <typename W>
+struct KruskalTree {
+    int n = 0;                      // Leaves are nodes 1..n (slot 0 unused)
+    std::vector<int32_t> component; // Leaf -> root of its tree in the forest
+    std::vector<int32_t> pos;       // Leaf -> number of internal nodes before it in order
+    std::vector<std::vector<W>> table; // table[k][i] = max of order weights i .. i + 2^k - 1
+
+    // edge_at(k) returns the k-th tree edge (fields u, v, w), in Kruskal order
+    template <typename EdgeAt>
+    void build(int num_nodes, std::size_t count, EdgeAt edge_at) {
+        n = num_nodes;
+        const std::size_t total = static_cast<std::size_t>(n) + 1 + count;
+        std::vector<int32_t> left(total, 0), right(total, 0);
+        std::vector<W> weight(total);
+
+        // 1. Replay the unions; node_of[root] is the tree node of a component
+        DSU dsu(n);
+        std::vector<int32_t> node_of(n + 1);
+        for (int v = 0; v <= n; v++) node_of[v] = v;
+        for (std::size_t k = 0; k < count; k++) {
+            auto e = edge_at(k);
+            int a = dsu.find(e.u), b = dsu.find(e.v);
+            if (a == b) continue;
+            int32_t x = static_cast<int32_t>(n + 1 + k);
+            left[x] = node_of[a];
+            right[x] = node_of[b];
+            weight[x] = e.w;
+            dsu.unite(a, b);
+            node_of[dsu.find(a)] = x;
+        }
+
+        // 2. In-order walk of every tree with an explicit stack
+        component.assign(n + 1, 0);
+        pos.assign(n + 1, 0);
+        std::vector<W> order;
+        order.reserve(count);
+        std::vector<int32_t> stack;
+        for (int v = 1; v <= n; v++) {
+            if (dsu.find(v) != v) continue;
+            int32_t root = node_of[v];
+            int32_t x = root;
+            while (x != 0 || !stack.empty()) {
+                while (x != 0) {
+                    stack.push_back(x);
+                    x = x > n ? left[x] : 0;
+                }
+                x = stack.back();
+                stack.pop_back();
+                if (x <= n) {
+                    component[x] = v;
+                    pos[x] = static_cast<int32_t>(order.size());
+                    x = 0;
+                } else {
+                    order.push_back(weight[x]);
+                    x = right[x];
+                }
+            }
+        }
+
+        // 3. Sparse table over the internal weights
+        table.assign(1, std::move(order));
+        for (std::size_t len = 2; len <= table[0].size(); len *= 2) {
+            const std::vector<W>& prev = table.back();
+            std::vector<W> next(table[0].size() - len + 1);
+            for (std::size_t i = 0; i < next.size(); i++) {
+                next[i] = prev[i] < prev[i + len / 2] ? prev[i + len / 2] : prev[i];
+            }
+            table.push_back(std::move(next));
+        }
+    }
+
+    bool connected(int u, int v) const { return component[u] == component[v]; }
+
+    // Heaviest MST edge on the path between u and v; needs u != v, connected
+    W path_max(int u, int v) const {
+        int l = pos[u], r = pos[v];
+        if (l > r) std::swap(l, r);
+        int k = 31 - __builtin_clz(static_cast<unsigned>(r - l));
+        const W& a = table[k][l];
+        const W& b = table[k][r - (1 << k)];
+        return a < b ? b : a;
+    }
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Latency histogram in constant memory, for long-running servers and load
+// generators. Values are nanoseconds; each power of two is split into 16
+// buckets, so a reported percentile is at most 1/16 above the true value.
+// Histograms from several threads combine with merge().
+struct LatencyHistogram {
+    static const int SUB = 16; // Buckets per power of two
+
+    std::vector<uint64_t> counts = std::vector<uint64_t>(64 * SUB, 0);
+    uint64_t total = 0;
+    uint64_t max_ns = 0;
+
+    static int bucket(uint64_t ns) {
+        if (ns < SUB) return static_cast<int>(ns);
+        int e = 63 - __builtin_clzll(ns); // >= 4
+        return (e - 3) * SUB + static_cast<int>((ns >> (e - 4)) & (SUB - 1));
+    }
+
+    // Largest value that lands in bucket b
+    static uint64_t upper_bound(int b) {
+        if (b < SUB) return static_cast<uint64_t>(b);
+        int e = b / SUB + 3;
+        uint64_t step = uint64_t(1) << (e - 4);
+        return (SUB + b % SUB) * step + step - 1;
+    }
+
+    void add(uint64_t ns) {
+        counts[bucket(ns)]++;
+        total++;
+        if (ns > max_ns) max_ns = ns;
+    }
+
+    void merge(const LatencyHistogram& o) {
+        for (std::size_t b = 0; b < counts.size(); b++) counts[b] += o.counts[b];
+        total += o.total;
+        if (o.max_ns > max_ns) max_ns = o.max_ns;
+    }
+
+    // Smallest bucket bound with at least p (0..1) of the values at or below it
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t need = static_cast<uint64_t>(p * total);
+        if (need == 0) need = 1;
+        uint64_t seen = 0;
+        for (std::size_t b = 0; b < counts.size(); b++) {
+            seen += counts[b];
+            if (seen >= need) {
+                uint64_t bound = upper_bound(static_cast<int>(b));
+                return bound < max_ns ? bound : max_ns;
+            }
+        }
+        return max_ns;
+    }
+
+    // "requests 1000 p50 12.3us p90 ... max ...us" on one line
+    std::string summary() const {
+        char buf[192];
+        std::snprintf(buf, sizeof(buf), "requests %llu p50 %.1fus p90 %.1fus p99 %.1fus p99.9 %.1fus max %.1fus",
+                      static_cast<unsigned long long>(total), percentile(0.5) / 1e3, percentile(0.9) / 1e3,
+                      percentile(0.99) / 1e3, percentile(0.999) / 1e3, max_ns / 1e3);
+        return buf;
+    }
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Link-cut tree (Sleator-Tarjan) over a forest of nodes 0..size-1, with a
+// key per node and the maximum key on any path. Everything is amortized
+// O(log n). To get path maxima over edge weights, give every edge its own
+// node carrying the weight, link it between its endpoints, and give the
+// vertex nodes a key below every edge key.
+//
+// Key needs operator<; none is the key of an empty path.
+//
+// Usage:
+//   LinkCutTree<Key> lct(n, none);
+//   int e = lct.add_node(key);         // Edge node
+//   lct.link(u, e); lct.link(e, v);
+//   Key heaviest = lct.path_max(a, b); // a, b connected
+//   lct.cut(u, e); lct.cut(e, v);
+
+template <typename Key>
+struct LinkCutTree {
+    struct Node {
+        int32_t child[2] = {0, 0};
+        int32_t parent = 0;
+        bool flip = false;
+        Key key, best;
+    };
+
+    // Slot 0 is the null node; node x lives in slot x + 1
+    std::vector<Node> t;
+    Key none;
+
+    explicit LinkCutTree(std::size_t n = 0, Key none_key = Key()) : none(none_key) {
+        t.resize(n + 1);
+        for (Node& x : t) x.key = x.best = none;
+    }
+
+    std::size_t size() const { return t.size() - 1; }
+
+    int add_node(Key key) {
+        t.emplace_back();
+        t.back().key = t.back().best = key;
+        return static_cast<int>(t.size()) - 2;
+    }
+
+    // Reuse an isolated node (cut from everything) with a new key
+    void reset_node(int x, Key key) {
+        Node& n = t[x + 1];
+        n = Node();
+        n.key = n.best = key;
+    }
+
+    bool connected(int a, int b) { return find_root(a + 1) == find_root(b + 1); }
+
+    // a and b must be in different trees
+    void link(int a, int b) {
+        make_root(a + 1);
+        t[a + 1].parent = b + 1;
+    }
+
+    // The edge a - b must exist
+    void cut(int a, int b) {
+        make_root(a + 1);
+        access(b + 1);
+        splay(b + 1);
+        t[b + 1].child[0] = 0;
+        t[a + 1].parent = 0;
+        pull(b + 1);
+    }
+
+    // Maximum key on the path a .. b (a, b connected)
+    Key path_max(int a, int b) {
+        make_root(a + 1);
+        access(b + 1);
+        splay(b + 1);
+        return t[b + 1].best;
+    }
+
+    void set_key(int a, Key key) {
+        access(a + 1);
+        splay(a + 1);
+        t[a + 1].key = key;
+        pull(a + 1);
+    }
+
+    Key key(int a) const { return t[a + 1].key; }
+
+private:
+    bool is_root(int x) const {
+        int p = t[x].parent;
+        return p == 0 || (t[p].child[0] != x && t[p].child[1] != x);
+    }
+
+    void pull(int x) {
+        Node& n = t[x];
+        n.best = n.key;
+        for (int c : n.child) {
+            if (c && n.best < t[c].best) n.best = t[c].best;
+        }
+    }
+
+    void push(int x) {
+        Node& n = t[x];
+        if (!n.flip) return;
+        std::swap(n.child[0], n.child[1]);
+        for (int c : n.child) {
+            if (c) t[c].flip = !t[c].flip;
+        }
+        n.flip = false;
+    }
+
+    void rotate(int x) {
+        int p = t[x].parent, g = t[p].parent;
+        int side = t[p].child[1] == x;
+        if (!is_root(p)) t[g].child[t[g].child[1] == p] = x;
+        t[x].parent = g;
+        t[p].child[side] = t[x].child[side ^ 1];
+        if (t[x].child[side ^ 1]) t[t[x].child[side ^ 1]].parent = p;
+        t[x].child[side ^ 1] = p;
+        t[p].parent = x;
+        pull(p);
+        pull(x);
+    }
+
+    void splay(int x) {
+        // Push pending flips from the top of this splay tree down to x
+        path.clear();
+        for (int y = x;; y = t[y].parent) {
+            path.push_back(y);
+            if (is_root(y)) break;
+        }
+        for (int i = static_cast<int>(path.size()) - 1; i >= 0; i--) push(path[i]);
+
+        while (!is_root(x)) {
+            int p = t[x].parent, g = t[p].parent;
+            if (!is_root(p)) rotate((t[g].child[1] == p) == (t[p].child[1] == x) ? p : x);
+            rotate(x);
+        }
+    }
+
+    void access(int x) {
+        for (int last = 0; x; last = x, x = t[x].parent) {
+            splay(x);
+            t[x].child[1] = last;
+            pull(x);
+        }
+    }
+
+    void make_root(int x) {
+        access(x);
+        splay(x);
+        t[x].flip = !t[x].flip;
+    }
+
+    int find_root(int x) {
+        access(x);
+        splay(x);
+        push(x);
+        while (t[x].child[0]) {
+            x = t[x].child[0];
+            push(x);
+        }
+        splay(x);
+        return x;
+    }
+
+    std::vector<int> path; // Scratch for splay()
+};
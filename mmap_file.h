@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// RAII wrapper around a memory-mapped file (POSIX).
+// open_read() maps an existing file read-only; create() makes a new file of a
+// given size and maps it read-write. Errors are reported on stderr and the
+// call returns false, matching how the programs treat bad input.
+struct MappedFile {
+    char* data = nullptr;
+    std::size_t size = 0;
+    int fd = -1;
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open_read(const char* path) {
+        close();
+        fd = ::open(path, O_RDONLY);
+        if (fd < 0) return fail("cannot open", path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) return fail("cannot stat", path);
+        size = static_cast<std::size_t>(st.st_size);
+        if (size == 0) return true;
+        void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) return fail("cannot map", path);
+        data = static_cast<char*>(p);
+        madvise(data, size, MADV_WILLNEED);
+        return true;
+    }
+
+    bool create(const char* path, std::size_t bytes) {
+        close();
+        fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return fail("cannot create", path);
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) return fail("cannot resize", path);
+        size = bytes;
+        if (size == 0) return true;
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) return fail("cannot map", path);
+        data = static_cast<char*>(p);
+        return true;
+    }
+
+    void close() {
+        if (data) munmap(data, size);
+        if (fd >= 0) ::close(fd);
+        data = nullptr;
+        size = 0;
+        fd = -1;
+    }
+
+private:
+    bool fail(const char* what, const char* path) {
+        std::cerr << what << " '" << path << "'\n";
+        close();
+        return false;
+    }
+};
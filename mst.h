@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "boruvka.h"
+#include "cli.h"
+#include "dsu.h"
+#include "radix_sort.h"
+
+// MST engines shared by the Kruskal-based programs.
+//
+// Every engine takes the edge list as read (it is never reordered), the node
+// count n, and a weight accessor, and returns the input positions of the tree
+// edges in Kruskal order: ascending weight, ties broken by input position.
+// All engines pick exactly the same tree, so callers can switch freely.
+//
+//   kruskal        : radix sort everything, scan until the forest is spanning
+//   filter-kruskal : quicksort-style partitioning; heavy edges already inside
+//                    one component are dropped before they are ever sorted
+//   boruvka        : multi-core Borůvka rounds (see boruvka.h)
+
+struct MSTStats {
+    std::size_t edges_total = 0;
+    std::size_t tree_edges = 0;
+    std::size_t filtered = 0;  // Dropped by a connectivity filter before sorting
+    std::size_t unscanned = 0; // Never looked at because the forest was already spanning
+
+    std::size_t skipped() const { return filtered + unscanned; }
+};
+
+inline void print_mst_stats(const char* engine, const MSTStats& s) {
+    std::cerr << engine << ": m = " << s.edges_total << ", tree edges = " << s.tree_edges
+              << ", skipped = " << s.skipped() << " (filtered " << s.filtered
+              << ", unscanned " << s.unscanned << ")\n";
+}
+
+// Number of tree edges a spanning tree over n nodes needs (early-exit target)
+inline std::size_t spanning_target(std::size_t n) {
+    return n > 0 ? n - 1 : 0;
+}
+
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> kruskal_tree(const Edges& edges, int n, WeightOf weight_of, MSTStats* stats = nullptr) {
+    std::vector<uint32_t> order = radix_sort_order(edges, weight_of);
+
+    DSU dsu(n);
+    std::vector<uint32_t> tree;
+    const std::size_t target = spanning_target(n);
+    std::size_t scanned = 0;
+
+    for (uint32_t pos : order) {
+        if (tree.size() == target) break;
+        scanned++;
+        if (dsu.unite(edges[pos].u, edges[pos].v)) tree.push_back(pos);
+    }
+
+    if (stats) {
+        stats->edges_total = edges.size();
+        stats->tree_edges = tree.size();
+        stats->filtered = 0;
+        stats->unscanned = edges.size() - scanned;
+    }
+    return tree;
+}
+
+// Below this many edges a range is just sorted and scanned
+const std::size_t FILTER_KRUSKAL_BASE = 1024;
+
+template <typename Edges, typename WeightOf>
+struct FilterKruskal {
+    const Edges& edges;
+    WeightOf weight_of;
+    DSU dsu;
+    std::size_t target;
+    std::vector<uint32_t> tree;
+    std::size_t filtered = 0;
+    std::size_t unscanned = 0;
+    std::mt19937 rng{12345}; // Fixed seed: same pivots, same run time profile every run
+
+    FilterKruskal(const Edges& e, int n, WeightOf w)
+        : edges(e), weight_of(w), dsu(n), target(spanning_target(n)) {}
+
+    // Strict order on input positions: by weight, then by position
+    bool less(uint32_t a, uint32_t b) const {
+        auto wa = weight_of(edges[a]);
+        auto wb = weight_of(edges[b]);
+        return wa < wb || (!(wb < wa) && a < b);
+    }
+
+    bool done() const { return tree.size() == target; }
+
+    void base_case(uint32_t* first, uint32_t* last) {
+        std::sort(first, last, [&](uint32_t a, uint32_t b) { return less(a, b); });
+        uint32_t* p = first;
+        for (; p != last && !done(); ++p) {
+            if (dsu.unite(edges[*p].u, edges[*p].v)) tree.push_back(*p);
+        }
+        unscanned += last - p;
+    }
+
+    uint32_t pick_pivot(uint32_t* first, uint32_t* last) {
+        std::uniform_int_distribution<std::size_t> pick(0, last - first - 1);
+        uint32_t a = first[pick(rng)], b = first[pick(rng)], c = first[pick(rng)];
+        // Median of three
+        if (less(b, a)) std::swap(a, b);
+        if (less(c, b)) std::swap(b, c);
+        if (less(b, a)) std::swap(a, b);
+        return b;
+    }
+
+    void run(uint32_t* first, uint32_t* last) {
+        if (first == last) return;
+        if (done()) {
+            unscanned += last - first;
+            return;
+        }
+        if (static_cast<std::size_t>(last - first) <= FILTER_KRUSKAL_BASE) {
+            base_case(first, last);
+            return;
+        }
+
+        uint32_t pivot = pick_pivot(first, last);
+        uint32_t* mid = std::partition(first, last, [&](uint32_t p) { return !less(pivot, p); });
+
+        run(first, mid);
+        if (done()) {
+            unscanned += last - mid;
+            return;
+        }
+
+        // Heavy edges whose endpoints are already connected can never join the tree
+        uint32_t* keep = std::remove_if(mid, last, [&](uint32_t p) {
+            return dsu.same(edges[p].u, edges[p].v);
+        });
+        filtered += last - keep;
+        run(mid, keep);
+    }
+};
+
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> filter_kruskal_tree(const Edges& edges, int n, WeightOf weight_of, MSTStats* stats = nullptr) {
+    std::vector<uint32_t> positions(edges.size());
+    for (std::size_t i = 0; i < positions.size(); i++) positions[i] = static_cast<uint32_t>(i);
+
+    FilterKruskal<Edges, WeightOf> fk(edges, n, weight_of);
+    fk.run(positions.data(), positions.data() + positions.size());
+
+    if (stats) {
+        stats->edges_total = edges.size();
+        stats->tree_edges = fk.tree.size();
+        stats->filtered = fk.filtered;
+        stats->unscanned = fk.unscanned;
+    }
+    return std::move(fk.tree);
+}
+
+enum class MSTEngine { Kruskal, FilterKruskal, Boruvka };
+
+// Parses the value of --engine=...; unknown names fall back to the default
+inline MSTEngine parse_mst_engine(const char* name, MSTEngine fallback = MSTEngine::FilterKruskal) {
+    if (!name) return fallback;
+    if (std::strcmp(name, "kruskal") == 0) return MSTEngine::Kruskal;
+    if (std::strcmp(name, "filter") == 0 || std::strcmp(name, "filter-kruskal") == 0) return MSTEngine::FilterKruskal;
+    if (std::strcmp(name, "boruvka") == 0) return MSTEngine::Boruvka;
+    std::cerr << "unknown MST engine '" << name << "', using default\n";
+    return fallback;
+}
+
+inline const char* mst_engine_name(MSTEngine engine) {
+    switch (engine) {
+        case MSTEngine::Kruskal: return "kruskal";
+        case MSTEngine::FilterKruskal: return "filter-kruskal";
+        case MSTEngine::Boruvka: return "boruvka";
+    }
+    return "?";
+}
+
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> boruvka_mst_tree(const Edges& edges, int n, WeightOf weight_of, unsigned num_threads,
+                                       MSTStats* stats = nullptr) {
+    BoruvkaStats bs;
+    std::vector<uint32_t> tree = boruvka_tree(edges, n, weight_of, num_threads, &bs);
+    if (stats) {
+        stats->edges_total = edges.size();
+        stats->tree_edges = tree.size();
+        stats->filtered = bs.dropped;
+        stats->unscanned = bs.remaining;
+    }
+    return tree;
+}
+
+// num_threads only matters for the parallel engines (0 = all cores)
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> mst_tree_edges(MSTEngine engine, const Edges& edges, int n, WeightOf weight_of,
+                                     MSTStats* stats = nullptr, unsigned num_threads = 0) {
+    switch (engine) {
+        case MSTEngine::Kruskal: return kruskal_tree(edges, n, weight_of, stats);
+        case MSTEngine::FilterKruskal: return filter_kruskal_tree(edges, n, weight_of, stats);
+        case MSTEngine::Boruvka: return boruvka_mst_tree(edges, n, weight_of, num_threads, stats);
+    }
+    return {};
+}
+
+// Options every MST-building program accepts:
+//   --engine=kruskal|filter|boruvka   (default: filter)
+//   --threads=N                       (parallel engines only, default: all cores)
+//   --stats                           (print skipped-edge counts to stderr)
+struct MSTOptions {
+    MSTEngine engine = MSTEngine::FilterKruskal;
+    unsigned threads = 0;
+    bool show_stats = false;
+};
+
+inline MSTOptions parse_mst_options(int argc, char** argv) {
+    MSTOptions opt;
+    opt.engine = parse_mst_engine(flag_value(argc, argv, "--engine"));
+    opt.threads = static_cast<unsigned>(std::atoi(flag_value(argc, argv, "--threads", "0")));
+    opt.show_stats = has_flag(argc, argv, "--stats");
+    return opt;
+}
+
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> build_mst(const MSTOptions& opt, const Edges& edges, int n, WeightOf weight_of) {
+    MSTStats stats;
+    std::vector<uint32_t> tree = mst_tree_edges(opt.engine, edges, n, weight_of, &stats, opt.threads);
+    if (opt.show_stats) print_mst_stats(mst_engine_name(opt.engine), stats);
+    return tree;
+}
@@ -3,6 +3,12 @@
 #include <algorithm>
 #include <map>
 
+#include "csr.h"
+#include "dedup.h"
+#include "dsu.h"
+#include "edge_input.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 // Structure to represent an edge
@@ -10,36 +16,11 @@ struct Edge {
     int u, v, w, id;
 };
 
-// Comparator for sorting edges
-bool compareEdges(const Edge& a, const Edge& b) {
-    return a.w < b.w;
-}
-
-// Disjoint Set Union (DSU) structure
-struct DSU {
-    vector<int> parent;
-    DSU(int n) {
-        parent.resize(n + 1);
-        for (int i = 0; i <= n; ++i) parent[i] = i;
-    }
-    int find(int i) {
-        if (parent[i] == i)
-            return i;
-        return parent[i] = find(parent[i]);
-    }
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-        }
-    }
-};
-
 // Global variables for Bridge Finding
-const int MAXN = 1005; // Adjust based on N constraints
-vector<pair<int, int>> temp_adj[MAXN]; // Adjacency list for component graph: {neighbor, edge_id}
-int tin[MAXN], low[MAXN];
+// The component graph only spans the DSU roots touched by one weight block,
+// renumbered 0..k-1, so there is no node cap
+CSRGraph<int> temp_adj; // Component graph, arc data = edge_id
+vector<int> tin, low;
 int timer;
 vector<int> critical_edges; // To store IDs of critical edges
 
@@ -48,9 +29,9 @@ vector<int> critical_edges; // To store IDs of critical edges
 void dfs_bridges(int u, int p_edge_id = -1) {
     tin[u] = low[u] = ++timer;
     
-    for (auto& edge : temp_adj[u]) {
-        int v = edge.first;
-        int id = edge.second;
+    for (uint32_t a = temp_adj.begin(u); a < temp_adj.end(u); a++) {
+        int v = temp_adj.target[a];
+        int id = temp_adj.data[a];
         
         if (id == p_edge_id) continue; // Don't go back along the same edge
         
@@ -70,33 +51,57 @@ void dfs_bridges(int u, int p_edge_id = -1) {
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Fast I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int N, M;
-    if (!(cin >> N >> M)) return 0;
-
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    int N;
     vector<Edge> edges;
-    for (int i = 0; i < M; ++i) {
-        int u, v, w;
-        cin >> u >> v >> w;
-        edges.push_back({u, v, w, i});
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, N, edges)) return 0;
+    int M = edges.size();
+    for (int i = 0; i < M; ++i) edges[i].id = i;
+
+    // --dedup: keep one copy per pair (--stats prints the reduction). A kept
+    // edge with an equally light dropped copy is never critical (the copy can
+    // replace it); heavier copies and self-loops never are either.
+    vector<bool> has_tie;
+    if (has_flag(argc, argv, "--dedup")) {
+        DedupResult dedup = dedup_edges(edges, [](const Edge& e) { return e.w; });
+        if (has_flag(argc, argv, "--stats")) print_dedup_stats(dedup.stats);
+        keep_edges(edges, dedup.kept);
+        has_tie.assign(M, false);
+        for (int i = 0; i < M; ++i) {
+            if (dedup.rep[i] < DEDUP_DOMINATED && dedup.rep[i] != (uint32_t)i) has_tie[dedup.rep[i]] = true;
+        }
     }
+    int count = edges.size();
 
     // Step 1: Sort edges by weight
-    sort(edges.begin(), edges.end(), compareEdges);
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; });
 
     DSU dsu(N);
     int edge_idx = 0;
 
+    vector<int> local_id(N + 1, -1);   // DSU root -> node of the component graph
+    vector<int> batch_roots;           // Node of the component graph -> DSU root
+    vector<CSREdge<int>> batch_edges;  // Component graph edges {node, node, edge_id}
+    auto local = [&](int root) {
+        if (local_id[root] == -1) {
+            local_id[root] = batch_roots.size();
+            batch_roots.push_back(root);
+        }
+        return local_id[root];
+    };
+
     // Step 2: Process edges in blocks of equal weight
-    while (edge_idx < M) {
+    while (edge_idx < count) {
         int j = edge_idx;
         
         // Find the range [edge_idx, j) containing all edges of the same weight
-        while (j < M && edges[j].w == edges[edge_idx].w) {
+        while (j < count && edges[j].w == edges[edge_idx].w) {
             j++;
         }
 
@@ -105,7 +110,6 @@ int main() {
         
         // Reset specialized containers for this batch
         timer = 0;
-        vector<int> nodes_in_batch; 
 
         for (int k = edge_idx; k < j; ++k) {
             int u = edges[k].u;
@@ -117,31 +121,27 @@ int main() {
                 // Add edge between components. 
                 // Note: We might add multiple edges between the same two roots!
                 // The bridge finding logic handles this naturally (multiple edges = cycle = not a bridge).
-                temp_adj[root_u].push_back({root_v, edges[k].id});
-                temp_adj[root_v].push_back({root_u, edges[k].id});
-                
-                nodes_in_batch.push_back(root_u);
-                nodes_in_batch.push_back(root_v);
-                
-                // Reset visited arrays for these specific nodes
-                tin[root_u] = 0; 
-                tin[root_v] = 0;
-                low[root_u] = 0;
-                low[root_v] = 0;
+                batch_edges.push_back({local(root_u), local(root_v), edges[k].id});
             }
         }
 
+        int batch_nodes = batch_roots.size();
+        temp_adj.build(batch_nodes, batch_edges.size(), [&](size_t k) { return batch_edges[k]; });
+        // Reset visited arrays for the nodes of this block only
+        tin.assign(batch_nodes, 0);
+        low.assign(batch_nodes, 0);
+
         // --- PHASE 2: Find Bridges ---
-        for (int node : nodes_in_batch) {
+        for (int node = 0; node < batch_nodes; ++node) {
             if (!tin[node]) {
                 dfs_bridges(node);
             }
         }
 
         // --- PHASE 3: Clean up and Unite ---
-        for (int node : nodes_in_batch) {
-            temp_adj[node].clear(); // Clear adjacency list for next batch
-        }
+        for (int root : batch_roots) local_id[root] = -1;
+        batch_roots.clear();
+        batch_edges.clear();
 
         // Now actually perform the unions in DSU
         for (int k = edge_idx; k < j; ++k) {
@@ -153,13 +153,18 @@ int main() {
     }
 
     // Output Result
+    if (!has_tie.empty()) {
+        critical_edges.erase(remove_if(critical_edges.begin(), critical_edges.end(),
+                                       [&](int id) { return has_tie[id]; }),
+                             critical_edges.end());
+    }
     sort(critical_edges.begin(), critical_edges.end());
     
-    cout << "Number of Critical Edges: " << critical_edges.size() << endl;
+    cout << "Number of Critical Edges: " << critical_edges.size() << "\n";
     
     // Optional: Print the specific edges (by their original index if needed)
     // for (int id : critical_edges) cout << id << " ";
-    // cout << endl;
+    // cout << "\n";
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "dsu.h"
+#include "edge_store.h"
+
+// Offline dynamic minimum spanning forest: with the whole update sequence
+// known up front, the forest weight after every update, in
+// O((M + Q) log(M + Q) log N) total.
+//
+// Divide and conquer over the query range [l, r]. The edges changed inside
+// the range are "changing", the rest have a fixed weight for all of it:
+//   - contraction: with every changing edge forced in first, the fixed edges
+//     that Kruskal still takes are in the forest for every query in the
+//     range; unite them for good and add their weight;
+//   - reduction: with every changing edge pushed out last, the fixed edges
+//     that Kruskal skips are in the forest for no query in the range; drop
+//     them.
+// What survives is O(r - l + 1) edges, so the two halves recurse on small
+// lists. Unions go through a RollbackDSU, undone on the way back up; the
+// left half runs first and leaves its updates applied for the right half.
+//
+// Deleted (and not yet inserted) edges stay in the graph as "absent": they
+// sort after every present edge and add nothing to the weight, which keeps
+// the forest over the present edges the minimum one.
+
+template <typename W>
+struct MSTUpdate {
+    uint32_t id;  // Edge to change; MSTUpdate::NONE for an update that changes nothing
+    bool present; // false: the edge is gone (deleted, or not inserted yet)
+    W w;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+};
+
+template <typename W>
+struct OfflineMST {
+    const EdgeStore<W>* edges = nullptr;
+    const std::vector<MSTUpdate<W>>* updates = nullptr;
+    std::vector<W> w;             // Current weight per edge
+    std::vector<uint8_t> present; // Current presence per edge
+    RollbackDSU dsu;
+    std::vector<uint32_t> mark; // Edge -> stamp of the last range that changes it
+    uint32_t stamp = 0;
+    std::vector<long long> cost; // Forest weight after each update
+
+    // edges: every edge that ever exists, with its initial weight; present:
+    // which of them exist before the first update
+    std::vector<long long> run(int n, const EdgeStore<W>& all_edges, std::vector<uint8_t> initially_present,
+                               const std::vector<MSTUpdate<W>>& all_updates) {
+        edges = &all_edges;
+        updates = &all_updates;
+        w.assign(all_edges.w.begin(), all_edges.w.end());
+        present = std::move(initially_present);
+        dsu.reset(n);
+        mark.assign(all_edges.size(), 0);
+        stamp = 0;
+        cost.assign(all_updates.size(), 0);
+        if (all_updates.empty()) return cost;
+
+        std::vector<uint32_t> sorted(all_edges.size());
+        for (uint32_t id = 0; id < sorted.size(); id++) sorted[id] = id;
+        std::sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b) { return before(a, b); });
+        solve(0, static_cast<int>(all_updates.size()) - 1, sorted, {}, 0);
+        return cost;
+    }
+
+private:
+    // Kruskal order: present edges by (weight, id), then the absent ones
+    bool before(uint32_t a, uint32_t b) const {
+        if (present[a] != present[b]) return present[a];
+        return w[a] < w[b] || (!(w[b] < w[a]) && a < b);
+    }
+
+    bool unite(uint32_t id) { return dsu.unite(edges->u[id], edges->v[id]); }
+
+    long long weight_of(uint32_t id) const { return present[id] ? static_cast<long long>(w[id]) : 0; }
+
+    // sorted: edges fixed over the parent range, in Kruskal order; loose:
+    // the parent's changing edges. base: weight of the contracted edges
+    void solve(int l, int r, const std::vector<uint32_t>& sorted, const std::vector<uint32_t>& loose, long long base) {
+        const std::vector<MSTUpdate<W>>& up = *updates;
+        const uint32_t t = ++stamp;
+        for (int k = l; k <= r; k++) {
+            if (up[k].id != MSTUpdate<W>::NONE) mark[up[k].id] = t;
+        }
+
+        // Split into this range's changing edges and its fixed ones, the
+        // latter back in Kruskal order
+        std::vector<uint32_t> changing, fixed, settled;
+        fixed.reserve(sorted.size() + loose.size());
+        for (uint32_t id : sorted) (mark[id] == t ? changing : fixed).push_back(id);
+        for (uint32_t id : loose) (mark[id] == t ? changing : settled).push_back(id);
+        auto order = [&](uint32_t a, uint32_t b) { return before(a, b); };
+        std::sort(settled.begin(), settled.end(), order);
+        std::size_t middle = fixed.size();
+        fixed.insert(fixed.end(), settled.begin(), settled.end());
+        std::inplace_merge(fixed.begin(), fixed.begin() + middle, fixed.end(), order);
+
+        const std::size_t entry = dsu.checkpoint();
+        if (l == r) {
+            // Apply the update and run Kruskal on what is left
+            if (up[l].id != MSTUpdate<W>::NONE) {
+                w[up[l].id] = up[l].w;
+                present[up[l].id] = up[l].present;
+            }
+            for (uint32_t id : changing) fixed.insert(std::upper_bound(fixed.begin(), fixed.end(), id, order), id);
+            long long total = base;
+            for (uint32_t id : fixed) {
+                if (unite(id)) total += weight_of(id);
+            }
+            dsu.rollback(entry);
+            cost[l] = total;
+            return;
+        }
+
+        // Contraction
+        std::vector<uint32_t> forced;
+        for (uint32_t id : changing) unite(id);
+        for (uint32_t id : fixed) {
+            if (unite(id)) forced.push_back(id);
+        }
+        dsu.rollback(entry);
+        for (uint32_t id : forced) {
+            unite(id);
+            base += weight_of(id);
+        }
+
+        // Reduction
+        const std::size_t contracted = dsu.checkpoint();
+        std::vector<uint32_t> kept;
+        for (uint32_t id : fixed) {
+            if (unite(id)) kept.push_back(id);
+        }
+        dsu.rollback(contracted);
+        std::vector<uint32_t>().swap(fixed);
+        std::vector<uint32_t>().swap(forced);
+
+        int mid = l + (r - l) / 2;
+        solve(l, mid, kept, changing, base);
+        solve(mid + 1, r, kept, changing, base);
+        dsu.rollback(entry);
+    }
+};
@@ -3,146 +3,92 @@
 #include <algorithm>
 #include <numeric>
 
+#include "dedup.h"
+#include "edge_input.h"
+#include "krt.h"
+#include "mst.h"
+#include "parallel.h"
+
 using namespace std;
 
 const int INF = 1e9;
 
-// Structure to represent an edge
-struct Edge {
-    int u, v, w;
-    int id; // To keep track of original index if needed
-};
-
-// Comparator for sorting edges by weight
-bool comparator(const Edge &a, const Edge &b) {
-    return a.w < b.w;
-}
-
-// Disjoint Set Union (DSU) for Kruskal's Algorithm
-struct DSU {
-    vector<int> parent;
-    DSU(int n) {
-        parent.resize(n + 1);
-        iota(parent.begin(), parent.end(), 0);
-    }
-    int find(int i) {
-        if (parent[i] == i)
-            return i;
-        return parent[i] = find(parent[i]);
-    }
-    bool unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-            return true;
-        }
-        return false;
-    }
-};
-
-// Global adjacency list to store the MST structure
-// Stores pairs of {neighbor, edge_weight}
-// Size 505 covers the constraint N <= 500
-vector<pair<int, int>> mst_adj[505];
-
-// DFS to find the maximum weight edge on the path between u and target in the MST
-// Returns:
-//   -1: if target is NOT found in this subtree
-//   val >= 0: the weight of the heaviest edge on the path found
-int getMaxOnPath(int u, int target, int p) {
-    // Base Case: We reached the target node. 
-    // The max weight on a path of length 0 is 0.
-    if (u == target) return 0;
-
-    for (auto &edge : mst_adj[u]) {
-        int v = edge.first;
-        int w = edge.second;
-        
-        // Avoid going back to parent
-        if (v != p) {
-            int res = getMaxOnPath(v, target, u);
-            
-            // If res is not -1, it means the target was found in this branch
-            if (res != -1) {
-                // The max edge on the path is either the one we just traversed (w)
-                // or the max edge found deeper in the recursion (res)
-                return max(w, res);
-            }
-        }
+void solve(int argc, char** argv) {
+    MSTOptions opt = parse_mst_options(argc, argv);
+
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    int N;
+    GraphEdges<int> edges; // Columnar and read-only; with --graph it stays in the mapped file
+    // "N M" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, N, edges)) return;
+
+    // --dedup: parallel copies and self-loops never change the answer
+    // (same MST, same path maxima), so only the lightest copy is kept
+    if (has_flag(argc, argv, "--dedup")) {
+        DedupResult dedup = dedup_edges(edges, [](const EdgeRef<int>& e) { return e.w; }, false, opt.threads);
+        if (opt.show_stats) print_dedup_stats(dedup.stats);
+        keep_edges(edges, dedup.kept);
     }
-    
-    // Target not found in any branch from this node
-    return -1;
-}
+    int M = edges.size();
 
-void solve() {
-    int N, M;
-    if (!(cin >> N >> M)) return;
-
-    // Reset adjacency list for multiple test cases (if needed)
-    for(int i=0; i<=N; ++i) mst_adj[i].clear();
-
-    vector<Edge> edges(M);
-    for (int i = 0; i < M; ++i) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
-        edges[i].id = i;
-    }
+    // --- Step 1: Build the MST with the selected engine ---
+    // The engine never reorders 'edges', so no sorted copy is needed
+    vector<uint32_t> tree = build_mst(opt, edges, N, [](const EdgeRef<int>& e) { return e.w; });
 
-    // --- Step 1: Standard Kruskal's to build the MST ---
-    // We work on a sorted copy of edges for Kruskal's
-    vector<Edge> sorted_edges = edges;
-    sort(sorted_edges.begin(), sorted_edges.end(), comparator);
-
-    DSU dsu(N);
     long long mst_weight = 0;
     int edges_count = 0;
 
-    for (const auto &edge : sorted_edges) {
-        if (dsu.unite(edge.u, edge.v)) {
-            mst_weight += edge.w;
-            edges_count++;
-            
-            // Add to MST Adjacency List (Undirected)
-            mst_adj[edge.u].push_back({edge.v, edge.w});
-            mst_adj[edge.v].push_back({edge.u, edge.w});
-        }
+    for (uint32_t pos : tree) {
+        EdgeRef<int> edge = edges[pos];
+        mst_weight += edge.w;
+        edges_count++;
     }
 
     // Edge Case: If the graph is disconnected, we can't form a spanning tree
     if (edges_count < N - 1) {
-        cout << "-1" << endl;
+        cout << "-1\n";
         return;
     }
 
+    // Kruskal reconstruction tree over the MST ('tree' is in Kruskal order):
+    // the heaviest MST edge between any two nodes is an O(1) lookup
+    KruskalTree<int> krt;
+    krt.build(N, tree.size(), [&](size_t k) { return edges[tree[k]]; });
+
     // --- Step 2: Iterate ALL edges to find the best savings ---
     // We check every possible bridge to enchant.
     // If we enchant edge (u, v), we effectively get a "discount" equal to
     // the heaviest edge on the cycle it forms (or itself if it was in the MST).
     
-    int max_savings = 0;
-
-    for (const auto &edge : edges) {
-        // Find the heaviest edge on the MST path between u and v
-        // If edge was IN the MST, the path is just the edge itself, so it returns edge.w
-        // If edge was NOT in the MST, it returns the max weight on the cycle.
-        int current_savings = getMaxOnPath(edge.u, edge.v, -1);
-        
-        if (current_savings > max_savings) {
-            max_savings = current_savings;
+    // O(1) per edge, so the scan is split across --threads
+    unsigned threads = resolve_thread_count(M, opt.threads, 1 << 16);
+    vector<int> chunk_savings(threads, 0);
+    parallel_chunks(M, threads, [&](unsigned t, size_t begin, size_t end) {
+        int best = 0;
+        for (size_t i = begin; i < end; ++i) {
+            EdgeRef<int> edge = edges[i];
+            // Heaviest edge on the MST path between u and v
+            // If edge was IN the MST, the path is just the edge itself, so it returns edge.w
+            // If edge was NOT in the MST, it returns the max weight on the cycle.
+            // A self-loop saves nothing.
+            int current_savings = edge.u == edge.v ? 0 : krt.path_max(edge.u, edge.v);
+            if (current_savings > best) best = current_savings;
         }
-    }
+        chunk_savings[t] = best;
+    });
+    int max_savings = *max_element(chunk_savings.begin(), chunk_savings.end());
 
     // Result is Original MST Cost - Max Possible Saving
-    cout << mst_weight - max_savings << endl;
+    cout << mst_weight - max_savings << "\n";
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Fast I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
     
-    solve();
+    // --engine=kruskal|filter|boruvka, --threads=N, --stats (see mst.h), --dedup (see dedup.h)
+    solve(argc, argv);
     
     return 0;
 }
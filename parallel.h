@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Minimal fork-join helpers shared by the multi-threaded engines.
+
+inline unsigned default_thread_count() {
+    unsigned t = std::thread::hardware_concurrency();
+    return t ? t : 1;
+}
+
+// Resolve a requested thread count (0 = all cores) for n work items, keeping at
+// least min_per_thread items per thread so small inputs stay single-threaded
+inline unsigned resolve_thread_count(std::size_t n, unsigned requested, std::size_t min_per_thread = 1) {
+    unsigned t = requested ? requested : default_thread_count();
+    std::size_t cap = std::max<std::size_t>(1, n / std::max<std::size_t>(1, min_per_thread));
+    if (t > cap) t = static_cast<unsigned>(cap);
+    return std::max(1u, t);
+}
+
+// Start of chunk t when [0, n) is split into num_threads contiguous chunks
+inline std::size_t chunk_begin(std::size_t n, unsigned num_threads, unsigned t) {
+    return n * t / num_threads;
+}
+
+// Run fn(t, begin, end) for every chunk t of [0, n), one thread per chunk.
+// Chunk t always covers a lower range than chunk t + 1 and the split only
+// depends on (n, num_threads), so two calls see the same chunks.
+template <typename Fn>
+void parallel_chunks(std::size_t n, unsigned num_threads, Fn fn) {
+    if (num_threads <= 1) {
+        fn(0u, std::size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+    for (unsigned t = 1; t < num_threads; t++) {
+        workers.emplace_back(fn, t, chunk_begin(n, num_threads, t), chunk_begin(n, num_threads, t + 1));
+    }
+    fn(0u, std::size_t(0), chunk_begin(n, num_threads, 1));
+    for (auto& w : workers) w.join();
+}
+
+// Run fn(i) for every i in [0, n)
+template <typename Fn>
+void parallel_for(std::size_t n, unsigned num_threads, Fn fn) {
+    parallel_chunks(n, num_threads, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) fn(i);
+    });
+}
+
+// Run fn(t, i) for every i in [0, n) on num_threads threads (t = the thread)
+// when the items take very different times. Thread t owns items t, t + T,
+// t + 2T, ... (T = num_threads), so a list sorted from the largest item
+// down starts evenly spread. A thread that runs out steals the next unstarted
+// items of the others; each item runs exactly once.
+template <typename Fn>
+void parallel_for_stealing(std::size_t n, unsigned num_threads, Fn fn) {
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < n; i++) fn(0u, i);
+        return;
+    }
+    struct alignas(64) Cursor {
+        std::atomic<std::size_t> next{0}; // Items taken from this thread's share
+    };
+    std::vector<Cursor> cursor(num_threads);
+    auto owned = [&](unsigned t) { return n / num_threads + (t < n % num_threads ? 1 : 0); };
+
+    parallel_chunks(num_threads, num_threads, [&](unsigned t, std::size_t, std::size_t) {
+        for (unsigned k = 0; k < num_threads; k++) {
+            unsigned victim = (t + k) % num_threads; // Own share first
+            std::size_t count = owned(victim);
+            std::size_t j;
+            while ((j = cursor[victim].next.fetch_add(1, std::memory_order_relaxed)) < count) {
+                fn(t, victim + j * num_threads);
+            }
+        }
+    });
+}
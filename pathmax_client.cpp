@@ -0,0 +1,46 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "cli.h"
+#include "unix_socket.h"
+
+using namespace std;
+
+// Command-line client for pathmax_server --socket=path.
+// Usage: pathmax_client --socket=path < requests > replies
+//
+// Requests are streamed from stdin to the server while replies are copied
+// to stdout, so a whole file of requests goes through pipelined, not one
+// round trip per line. Exits once the server has answered everything.
+
+int main(int argc, char** argv) {
+    const char* path = flag_value(argc, argv, "--socket");
+    if (!path) {
+        cerr << "usage: pathmax_client --socket=path\n";
+        return 1;
+    }
+    int fd = connect_unix(path);
+    if (fd < 0) return 1;
+
+    thread sender([fd] {
+        vector<char> buf(1 << 16);
+        ssize_t got;
+        while ((got = ::read(0, buf.data(), buf.size())) > 0) {
+            if (!write_all(fd, buf.data(), got)) break;
+        }
+        shutdown(fd, SHUT_WR); // The server answers the rest, then closes
+    });
+
+    vector<char> buf(1 << 16);
+    ssize_t got;
+    while ((got = ::read(fd, buf.data(), buf.size())) > 0) {
+        if (!write_all(1, buf.data(), got)) break;
+    }
+    sender.join();
+    ::close(fd);
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "edge_input.h"
+#include "krt.h"
+#include "latency.h"
+#include "mst.h"
+#include "parallel.h"
+#include "unix_socket.h"
+
+using namespace std;
+
+// Long-running MST query server: builds the index once, then answers
+// requests until its input ends (or SIGINT / SIGTERM with --socket).
+//
+// Usage: pathmax_server (--graph=path | --input=path) [--socket=path]
+//                       [--engine=...] [--threads=N] [--stats]
+//
+// One request per line, one reply line per request, in order; clients may
+// pipeline as many requests as they like:
+//   "M u v"    heaviest edge on the MST path between u and v, or "none" if
+//              they are not connected (or u == v)
+//   "C u v w"  "Yes" if u and v are connected through edges lighter than w,
+//              else "No"
+//   "S"        latency percentiles of the requests answered so far
+// Malformed requests get "error".
+//
+// Both queries are answered from the Kruskal reconstruction tree of the MST
+// (krt.h): two table lookups each. Without --socket requests come from stdin
+// and replies go to stdout; with --socket=path every connection to the Unix
+// domain socket is its own request stream. Every turn of the event loop
+// collects the complete lines of every ready stream into one batch, answers
+// it (on --threads when it is large) and queues the replies. A request's
+// latency runs from the turn that read it to the write() that finished its
+// reply; the percentiles also go to stderr at exit.
+//
+// Memory per connection is bounded: once MAX_PENDING_OUTPUT bytes of replies
+// are waiting for a client, its requests are not read until it takes them,
+// and a line longer than MAX_LINE gets "error" and ends the connection.
+
+struct Edge {
+    int u, v, w;
+};
+
+using Clock = chrono::steady_clock;
+
+const size_t MAX_PENDING_OUTPUT = 1 << 20; // Unsent reply bytes before reading pauses
+const size_t MAX_LINE = 1 << 12;           // Longest request line, far above any valid one
+
+struct Request {
+    uint32_t conn;
+    char kind; // 'M', 'C', 'S', or 'E' (malformed)
+    int u, v, w;
+};
+
+struct Connection {
+    int in_fd, out_fd;
+    bool socket;             // Non-blocking socket (else stdin / stdout)
+    vector<char> in;         // Read but not yet parsed (a partial line at the end)
+    string out;              // Replies not yet written
+    size_t out_sent = 0;
+    uint64_t appended = 0, written = 0; // Reply bytes ever queued / written
+    vector<pair<uint64_t, Clock::time_point>> waiting; // (end of reply, arrival) in order
+    size_t waiting_head = 0;
+    bool eof = false, dead = false;
+
+    Connection(int in, int out, bool is_socket) : in_fd(in), out_fd(out), socket(is_socket) {}
+};
+
+int N;
+KruskalTree<int> krt;
+LatencyHistogram latency;
+volatile sig_atomic_t stop_requested = 0;
+
+void on_signal(int) { stop_requested = 1; }
+
+// Parse "M u v", "C u v w" or "S" from [p, end)
+Request parse_request(uint32_t conn, const char* p, const char* end) {
+    using namespace fast_input_detail;
+    Request r{conn, 'E', 0, 0, 0};
+    p = skip_space(p, end);
+    if (p == end) return r;
+    char kind = *p++;
+    if (p != end && !is_space(*p)) return r;
+    int fields = kind == 'M' ? 2 : kind == 'C' ? 3 : kind == 'S' ? 0 : -1;
+    int value[3] = {0, 0, 0};
+    for (int k = 0; k < fields; k++) {
+        p = skip_space(p, end);
+        if (p == end || !(is_digit(*p) || *p == '-')) return r;
+        value[k] = parse_number<int>(p, end);
+    }
+    if (fields < 0 || skip_space(p, end) != end) return r;
+    if (fields > 0 && (value[0] < 1 || value[0] > N || value[1] < 1 || value[1] > N)) return r;
+    return {conn, kind, value[0], value[1], value[2]};
+}
+
+string answer(const Request& r) {
+    switch (r.kind) {
+        case 'M':
+            if (r.u == r.v || !krt.connected(r.u, r.v)) return "none\n";
+            return to_string(krt.path_max(r.u, r.v)) + "\n";
+        case 'C':
+            if (r.u == r.v || (krt.connected(r.u, r.v) && krt.path_max(r.u, r.v) < r.w)) return "Yes\n";
+            return "No\n";
+        case 'S':
+            return latency.summary() + "\n";
+        default:
+            return "error\n";
+    }
+}
+
+// Write as much queued output as the connection takes; records the latency
+// of every reply that is now fully written
+void flush_output(Connection& c) {
+    while (c.out_sent < c.out.size()) {
+        ssize_t wrote = ::write(c.out_fd, c.out.data() + c.out_sent, c.out.size() - c.out_sent);
+        if (wrote < 0 && errno == EINTR) continue;
+        if (wrote < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (wrote <= 0) {
+            c.dead = true;
+            return;
+        }
+        c.out_sent += wrote;
+        c.written += wrote;
+    }
+    Clock::time_point now = Clock::now();
+    while (c.waiting_head < c.waiting.size() && c.waiting[c.waiting_head].first <= c.written) {
+        latency.add(chrono::duration_cast<chrono::nanoseconds>(now - c.waiting[c.waiting_head].second).count());
+        c.waiting_head++;
+    }
+    if (c.out_sent == c.out.size()) {
+        c.out.clear();
+        c.out_sent = 0;
+        c.waiting.clear();
+        c.waiting_head = 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    ios_base::sync_with_stdio(false);
+
+    // The graph comes from a file: stdin may be the request stream
+    FastInput in;
+    if (flag_value(argc, argv, "--input")) in.open(argc, argv);
+    else if (!flag_value(argc, argv, "--graph")) {
+        cerr << "pathmax_server needs --graph=path or --input=path\n";
+        return 1;
+    }
+    vector<Edge> edges;
+    if (!read_graph(in, argc, argv, N, edges)) return 1;
+
+    // --engine=kruskal|filter|boruvka, --threads=N, --stats; see mst.h
+    MSTOptions opt = parse_mst_options(argc, argv);
+    vector<uint32_t> tree = build_mst(opt, edges, N, [](const Edge& e) { return e.w; });
+    krt.build(N, tree.size(), [&](size_t k) { return edges[tree[k]]; });
+    vector<Edge>().swap(edges);
+
+    signal(SIGPIPE, SIG_IGN);
+    struct sigaction sa = {};
+    sa.sa_handler = on_signal; // No SA_RESTART: poll() returns EINTR
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    vector<Connection> conns;
+    int listen_fd = -1;
+    if (const char* path = flag_value(argc, argv, "--socket")) {
+        listen_fd = listen_unix(path);
+        if (listen_fd < 0) return 1;
+        fcntl(listen_fd, F_SETFL, O_NONBLOCK);
+        cerr << "pathmax_server: n = " << N << ", listening on " << path << "\n";
+    } else {
+        conns.push_back(Connection(0, 1, false));
+    }
+
+    vector<pollfd> fds;
+    vector<Request> batch;
+    vector<string> replies;
+    while (!stop_requested) {
+        // 1. Wait for input, writable output or a new connection
+        fds.clear();
+        if (listen_fd >= 0) fds.push_back({listen_fd, POLLIN, 0});
+        for (const Connection& c : conns) {
+            bool backlogged = c.out.size() - c.out_sent >= MAX_PENDING_OUTPUT;
+            fds.push_back({c.eof || backlogged ? -1 : c.in_fd, POLLIN, 0});
+            fds.push_back({c.out_sent < c.out.size() ? c.out_fd : -1, POLLOUT, 0});
+        }
+        if (fds.empty()) break;
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        size_t f = 0;
+        if (listen_fd >= 0) {
+            if (fds[f++].revents & POLLIN) {
+                int fd;
+                while ((fd = accept(listen_fd, nullptr, nullptr)) >= 0) {
+                    fcntl(fd, F_SETFL, O_NONBLOCK);
+                    conns.push_back(Connection(fd, fd, true));
+                }
+            }
+        }
+
+        // 2. Read what is there and cut it into requests
+        batch.clear();
+        for (uint32_t i = 0; i < conns.size() && f < fds.size(); i++, f += 2) {
+            Connection& c = conns[i];
+            if (fds[f].revents & (POLLIN | POLLHUP | POLLERR)) {
+                size_t old = c.in.size();
+                c.in.resize(old + (1 << 16));
+                ssize_t got = ::read(c.in_fd, c.in.data() + old, 1 << 16);
+                c.in.resize(old + max<ssize_t>(got, 0));
+                if (got == 0 || (got < 0 && errno != EAGAIN && errno != EINTR)) c.eof = true;
+            }
+            const char* p = c.in.data();
+            const char* end = p + c.in.size();
+            while (true) {
+                const char* nl = find(p, end, '\n');
+                if (nl == end && !(c.eof && p != end)) break;
+                if (fast_input_detail::skip_space(p, nl) != nl) batch.push_back(parse_request(i, p, nl));
+                p = nl == end ? end : nl + 1;
+            }
+            c.in.erase(c.in.begin(), c.in.begin() + (p - c.in.data()));
+            if (c.in.size() > MAX_LINE) {
+                // No request is this long: answer "error" and stop reading
+                batch.push_back({i, 'E', 0, 0, 0});
+                c.in.clear();
+                c.eof = true;
+            }
+        }
+
+        // 3. Answer the batch; the index is read-only, so slices run in parallel
+        Clock::time_point arrival = Clock::now();
+        replies.assign(batch.size(), string());
+        unsigned threads = resolve_thread_count(batch.size(), opt.threads, 1 << 12);
+        parallel_for(batch.size(), threads, [&](size_t k) { replies[k] = answer(batch[k]); });
+        for (size_t k = 0; k < batch.size(); k++) {
+            Connection& c = conns[batch[k].conn];
+            c.out += replies[k];
+            c.appended += replies[k].size();
+            c.waiting.push_back({c.appended, arrival});
+        }
+
+        // 4. Send replies; drop finished connections
+        for (Connection& c : conns) {
+            if (c.out_sent < c.out.size()) flush_output(c);
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < conns.size(); i++) {
+            Connection& c = conns[i];
+            bool done = c.dead || (c.eof && c.in.empty() && c.out_sent == c.out.size());
+            if (done) {
+                if (c.socket) ::close(c.in_fd);
+                continue;
+            }
+            if (kept != i) conns[kept] = move(c);
+            kept++;
+        }
+        conns.erase(conns.begin() + kept, conns.end());
+        if (listen_fd < 0 && conns.empty()) break; // stdin ended and everything is written
+    }
+
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        ::unlink(flag_value(argc, argv, "--socket"));
+    }
+    cerr << "pathmax_server: " << latency.summary() << "\n";
+    return 0;
+}
@@ -2,96 +2,157 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <thread>
+
+#include "dedup.h"
+#include "dsu.h"
+#include "edge_input.h"
+#include "fast_output.h"
+#include "krt.h"
+#include "radix_sort.h"
 
 using namespace std;
 
 // Structure for original graph edges
 struct Edge {
     int u, v, w;
-    bool operator<(const Edge& other) const {
-        return w < other.w;
-    }
 };
 
 // Structure for queries to keep track of original index
 struct Query {
     int u, v, w;
     int id; // To print answers in the correct order
-    bool operator<(const Query& other) const {
-        return w < other.w;
-    }
 };
 
-// Standard DSU
-struct DSU {
-    vector<int> parent;
-    DSU(int n) {
-        parent.resize(n + 1);
-        iota(parent.begin(), parent.end(), 0);
-    }
-    int find(int i) {
-        if (parent[i] == i) return i;
-        return parent[i] = find(parent[i]);
+// Per-query answer, one byte per query; names in the same order
+enum Answer : uint8_t { NO, YES };
+const ResultTable ANSWER_NAMES = {"No", "Yes"};
+
+// --online: answer every query as soon as it arrives instead of sorting the
+// batch. The MST of the sorted edges goes into a Kruskal reconstruction tree
+// once; u and v are connected through edges lighter than w iff they are
+// connected in the MST and the heaviest edge on their MST path is lighter
+// than w, an O(1) lookup. Output is flushed whenever the input has nothing
+// more buffered, so an interactive caller gets each answer before it sends
+// the next query.
+void answer_online(FastInput& in, int n, const vector<Edge>& edges, bool binary) {
+    vector<uint32_t> tree;
+    DSU dsu(n);
+    for (size_t k = 0; k < edges.size(); k++) {
+        if (dsu.unite(edges[k].u, edges[k].v)) tree.push_back(k);
     }
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-        }
+    KruskalTree<int> krt;
+    krt.build(n, tree.size(), [&](size_t k) { return edges[tree[k]]; });
+
+    int q = 0;
+    in.read(q);
+    FastOutput out;
+    for (int k = 0; k < q; k++) {
+        if (!in.has_buffered_token()) out.flush();
+        int u, v, w;
+        if (!in.read(u, v, w)) break;
+        bool lighter_path = u == v || (krt.connected(u, v) && krt.path_max(u, v) < w);
+        write_result(out, lighter_path ? NO : YES, ANSWER_NAMES, binary);
     }
-};
+}
 
-int main() {
+int main(int argc, char** argv) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n, m;
-    if (!(cin >> n >> m)) return 0;
+    // All of stdin (or --input=path) in one go; --online reads it as it comes
+    bool online = has_flag(argc, argv, "--online");
+    FastInput in;
+    if (online) in.open_stream(argc, argv);
+    else in.open(argc, argv);
+    int n;
+    vector<Edge> edges;
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, n, edges)) return 0;
 
-    vector<Edge> edges(m);
-    for (int i = 0; i < m; i++) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
+    // --dedup: connectivity below a weight only needs the lightest copy of each pair
+    // (--stats prints the reduction)
+    if (has_flag(argc, argv, "--dedup")) {
+        DedupResult dedup = dedup_edges(edges, [](const Edge& e) { return e.w; });
+        if (has_flag(argc, argv, "--stats")) print_dedup_stats(dedup.stats);
+        keep_edges(edges, dedup.kept);
     }
+    int m = edges.size();
 
     // 1. Sort original edges by weight
-    sort(edges.begin(), edges.end());
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; });
 
-    int q;
-    cin >> q;
-    vector<Query> queries(q);
-    for (int i = 0; i < q; i++) {
-        cin >> queries[i].u >> queries[i].v >> queries[i].w;
-        queries[i].id = i;
+    if (online) {
+        answer_online(in, n, edges, has_flag(argc, argv, "--binary-output"));
+        return 0;
     }
 
-    // 2. Sort queries by weight
-    sort(queries.begin(), queries.end());
+    int q = 0;
+    in.read(q);
+    vector<Query> queries(q);
+    in.read_records<int, int, int>(q, [&](size_t i, int u, int v, int w) {
+        queries[i] = {u, v, w, (int)i};
+    });
 
-    DSU dsu(n);
-    vector<string> results(q);
-    int edge_idx = 0;
+    // 2. Sort queries by weight
+    radix_sort_edges(queries, [](const Query& q) { return q.w; });
 
     // 3. Process queries
-    for (const auto& query : queries) {
-        // Add all original edges that are strictly lighter than the current query
-        while (edge_idx < m && edges[edge_idx].w < query.w) {
-            dsu.unite(edges[edge_idx].u, edges[edge_idx].v);
-            edge_idx++;
+    // The sorted queries are split into one weight range per thread
+    // (--threads=N, default: all cores). A single sweep over the edges stops
+    // at every range boundary, flattens the DSU (each node points straight at
+    // its root) and hands a copy of it to that range's worker, which then
+    // replays only the edges inside its range. Answers are the same as one
+    // sequential sweep; the price is one n-entry snapshot per range.
+    unsigned threads = resolve_thread_count(q, atoi(flag_value(argc, argv, "--threads", "0")), 1 << 16);
+    vector<uint8_t> results(q);
+
+    // Sweep edges into dsu and answer the queries in [begin, end), starting at edge first_edge
+    auto answer_range = [&](DSU& dsu, int first_edge, size_t begin, size_t end) {
+        int edge_idx = first_edge;
+        for (size_t k = begin; k < end; k++) {
+            const Query& query = queries[k];
+            // Add all original edges that are strictly lighter than the current query
+            while (edge_idx < m && edges[edge_idx].w < query.w) {
+                dsu.unite(edges[edge_idx].u, edges[edge_idx].v);
+                edge_idx++;
+            }
+
+            // Check connectivity without modifying DSU for the query edge
+            if (dsu.find(query.u) != dsu.find(query.v)) {
+                results[query.id] = YES;
+            } else {
+                results[query.id] = NO;
+            }
         }
+    };
 
-        // Check connectivity without modifying DSU for the query edge
-        if (dsu.find(query.u) != dsu.find(query.v)) {
-            results[query.id] = "Yes";
-        } else {
-            results[query.id] = "No";
+    DSU dsu(n);
+    if (threads <= 1) {
+        answer_range(dsu, 0, 0, q);
+    } else {
+        vector<thread> workers;
+        int edge_idx = 0;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t begin = chunk_begin(q, threads, t), end = chunk_begin(q, threads, t + 1);
+            while (edge_idx < m && edges[edge_idx].w < queries[begin].w) {
+                dsu.unite(edges[edge_idx].u, edges[edge_idx].v);
+                edge_idx++;
+            }
+            for (int v = 0; v <= n; v++) {
+                if (dsu.parent[v] >= 0) dsu.parent[v] = dsu.find(v);
+            }
+            workers.emplace_back([&, begin, end, first_edge = edge_idx, snapshot = dsu]() mutable {
+                answer_range(snapshot, first_edge, begin, end);
+            });
         }
+        for (auto& w : workers) w.join();
     }
 
     // 4. Output results in original order
-    for (const string& res : results) {
-        cout << res << "\n";
-    }
+    // (--binary-output writes the raw answer bytes instead)
+    FastOutput out;
+    write_results(out, results, ANSWER_NAMES, has_flag(argc, argv, "--binary-output"));
 
     return 0;
 }
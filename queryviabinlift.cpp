@@ -3,163 +3,180 @@
 #include <algorithm>
 #include <numeric>
 
-using namespace std;
+#include "binary_lifting.h"
+#include "csr.h"
+#include "dedup.h"
+#include "edge_input.h"
+#include "fast_output.h"
+#include "hld.h"
+#include "incremental_mst.h"
+#include "index_file.h"
+#include "krt.h"
+#include "mst.h"
 
-const int LOG = 20; // Sufficient for N up to ~10^6
+using namespace std;
 
 struct Edge {
     int u, v, w;
-    bool operator<(const Edge& other) const {
-        return w < other.w;
-    }
 };
 
-// DSU for Kruskal's Algorithm
-struct DSU {
-    vector<int> parent;
-    DSU(int n) {
-        parent.resize(n + 1);
-        iota(parent.begin(), parent.end(), 0);
-    }
-    int find(int i) {
-        if (parent[i] == i) return i;
-        return parent[i] = find(parent[i]);
-    }
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) parent[root_i] = root_j;
-    }
-};
+// Per-query answer, one byte per query; names in the same order
+enum Answer : uint8_t { NO, YES };
+const ResultTable ANSWER_NAMES = {"No", "Yes"};
 
-// Global variables for LCA
-vector<vector<pair<int, int>>> mst_adj;
-vector<int> depth;
-vector<vector<int>> up;
-vector<vector<int>> max_w;
-vector<int> component; // To handle disconnected graphs
-
-// DFS to build Binary Lifting table
-void dfs(int u, int p, int w, int d, int comp_id) {
-    depth[u] = d;
-    component[u] = comp_id;
-    up[u][0] = p;
-    max_w[u][0] = w;
-
-    for (int i = 1; i < LOG; i++) {
-        up[u][i] = up[up[u][i-1]][i-1];
-        // The max weight for 2^i is the max of the two 2^(i-1) segments
-        max_w[u][i] = max(max_w[u][i-1], max_w[up[u][i-1]][i-1]);
-    }
+// Path-max index over the MST, picked with --index:
+//   lifting (default): binary lifting, O(log N) dependent jumps (binary_lifting.h)
+//   hld              : heavy-light decomposition + sparse table, one O(1) range
+//                      max per chain crossed, usually one or two (hld.h)
+//   krt              : Kruskal reconstruction tree, two table lookups (krt.h)
+// Each needs connected(u, v) and path_max(u, v) for u != v.
 
-    for (auto& edge : mst_adj[u]) {
-        int v = edge.first;
-        int weight = edge.second;
-        if (v != p) {
-            dfs(v, u, weight, d + 1, comp_id);
-        }
-    }
-}
-
-// Function to find max edge weight on path between u and v
-int get_max_on_path(int u, int v) {
-    if (depth[u] < depth[v]) swap(u, v);
-
-    int res = 0;
+struct Query {
+    int u, v, w;
+};
 
-    // 1. Lift u to the same depth as v
-    for (int i = LOG - 1; i >= 0; i--) {
-        if (depth[u] - (1 << i) >= depth[v]) {
-            res = max(res, max_w[u][i]);
-            u = up[u][i];
+// The index is read-only once built, so the whole query block is parsed
+// first (in parallel, see FastInput::read_records), then cut into one
+// contiguous slice per thread (--threads=N, default: all cores); every thread
+// answers its slice into a shared answer array, which is written in order.
+template <typename Index>
+void answer_queries(const Index& index, FastInput& in, bool binary, unsigned num_threads) {
+    int q = 0;
+    in.read(q);
+    vector<Query> queries(q);
+    in.read_records<int, int, int>(q, [&](size_t i, int u, int v, int w) { queries[i] = {u, v, w}; }, num_threads);
+
+    vector<uint8_t> results(q);
+    unsigned threads = resolve_thread_count(q, num_threads, 1 << 14);
+    parallel_for(q, threads, [&](size_t i) {
+        const Query& query = queries[i];
+        // If nodes are in different connected components of the original graph,
+        // the edge bridges them and is definitely in the MST.
+        // A self-loop never is.
+        if (query.u == query.v) {
+            results[i] = NO;
+        } else if (!index.connected(query.u, query.v)) {
+            results[i] = YES;
+        } else {
+            // If new edge is cheaper or equal, it can replace the heaviest edge on the path.
+            // This is the true path max: older versions started it at 0, so with
+            // negative weights any w <= 0 wrongly answered Yes.
+            results[i] = query.w <= index.path_max(query.u, query.v) ? YES : NO;
         }
-    }
+    });
 
-    if (u == v) return res;
+    // Answers go through one output buffer (--binary-output: one raw byte per query)
+    FastOutput out;
+    write_results(out, results, ANSWER_NAMES, binary);
+}
 
-    // 2. Lift both until they are just below LCA
-    for (int i = LOG - 1; i >= 0; i--) {
-        if (up[u][i] != up[v][i]) {
-            res = max(res, max_w[u][i]);
-            res = max(res, max_w[v][i]);
-            u = up[u][i];
-            v = up[v][i];
+// --ops: the graph keeps growing while it is queried. After "q" come q
+// operations, answered in order:
+//   "1 u v w"  a new edge (u, v, w) joins the graph
+//   "2 u v w"  query as above, against the graph so far
+// The MST lives in a link-cut tree (incremental_mst.h): a new edge swaps out
+// the heaviest edge on its tree path if that one is heavier, and both that and
+// a query cost O(log N) amortized instead of a rebuild. Answers are the same
+// as rebuilding the index after every new edge. Truncated input or an
+// unknown op code stops the stream with an error after the answers so far.
+enum Op { ADD = 1, QUERY = 2 };
+
+bool answer_ops(IncrementalMST<int>& mst, FastInput& in, bool binary) {
+    int q = 0;
+    in.read(q);
+    FastOutput out;
+    for (int i = 0; i < q; i++) {
+        int op = 0, u = 0, v = 0, w = 0;
+        if (!in.read(op, u, v, w)) {
+            cerr << "input ends after " << i << " of " << q << " operations\n";
+            return false;
+        }
+        if (op != ADD && op != QUERY) {
+            cerr << "unknown op " << op << " in operation " << i + 1 << "\n";
+            return false;
+        }
+        if (op == ADD) {
+            mst.insert(u, v, w);
+            continue;
         }
+        uint8_t result;
+        if (u == v) result = NO;
+        else if (!mst.connected(u, v)) result = YES;
+        else result = w <= mst.path_max(u, v) ? YES : NO;
+        write_result(out, result, ANSWER_NAMES, binary);
     }
-
-    // 3. Account for the final edges to LCA
-    res = max(res, max_w[u][0]);
-    res = max(res, max_w[v][0]);
-    
-    return res;
+    return true;
 }
 
-int main() {
+int main(int argc, char** argv) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n, m;
-    if (!(cin >> n >> m)) return 0;
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    bool binary = has_flag(argc, argv, "--binary-output");
+
+    // --engine=kruskal|filter|boruvka, --threads=N, --stats; see mst.h
+    MSTOptions opt = parse_mst_options(argc, argv);
 
-    vector<Edge> edges(m);
-    for (int i = 0; i < m; i++) {
-        cin >> edges[i].u >> edges[i].v >> edges[i].w;
+    // --load-index=path: answer from a snapshot written by --save-index
+    // (index_file.h) without touching the graph; the input is just the queries
+    if (const char* path = flag_value(argc, argv, "--load-index")) {
+        IndexFile file;
+        BinaryLifting<int> lift;
+        if (!file.open(path) || !file.attach(path, lift)) return 1;
+        answer_queries(lift, in, binary, opt.threads);
+        return 0;
     }
 
-    // Sort edges for Kruskal's
-    sort(edges.begin(), edges.end());
+    int n;
+    vector<Edge> edges;
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, n, edges)) return 1;
 
-    // Build MST
-    DSU dsu(n);
-    mst_adj.resize(n + 1);
-    int edges_count = 0;
-    
-    for (const auto& e : edges) {
-        if (dsu.find(e.u) != dsu.find(e.v)) {
-            dsu.unite(e.u, e.v);
-            mst_adj[e.u].push_back({e.v, e.w});
-            mst_adj[e.v].push_back({e.u, e.w});
-            edges_count++;
-        }
+    // --dedup: only the lightest copy of a pair can be in the MST
+    if (has_flag(argc, argv, "--dedup")) {
+        DedupResult dedup = dedup_edges(edges, [](const Edge& e) { return e.w; }, false, opt.threads);
+        if (opt.show_stats) print_dedup_stats(dedup.stats);
+        keep_edges(edges, dedup.kept);
     }
 
-    // Initialize LCA structures
-    depth.resize(n + 1);
-    component.resize(n + 1, 0);
-    up.assign(n + 1, vector<int>(LOG));
-    max_w.assign(n + 1, vector<int>(LOG));
-
-    // Run DFS on each component (forest handling)
-    int comp_id = 0;
-    for (int i = 1; i <= n; i++) {
-        if (component[i] == 0) { // If node not visited
-            comp_id++;
-            // Root of component has parent as itself with weight 0 (or -1)
-            dfs(i, i, 0, 0, comp_id);
-        }
+    // Build MST
+    vector<uint32_t> tree = build_mst(opt, edges, n, [](const Edge& e) { return e.w; });
+
+    if (has_flag(argc, argv, "--ops")) {
+        IncrementalMST<int> mst(n);
+        for (uint32_t k : tree) mst.insert(edges[k].u, edges[k].v, edges[k].w);
+        vector<Edge>().swap(edges);
+        return answer_ops(mst, in, binary) ? 0 : 1;
     }
 
-    int q;
-    cin >> q;
-    while (q--) {
-        int u, v, w;
-        cin >> u >> v >> w;
+    // --save-index=path also writes the built index out (lifting only)
+    const char* save_path = flag_value(argc, argv, "--save-index");
+    string index = flag_value(argc, argv, "--index", "lifting");
+    if (save_path && index != "lifting") cerr << "--save-index only stores the lifting index\n";
+    if (index == "krt") {
+        // The engines return tree edges in Kruskal order, as build() wants them
+        KruskalTree<int> krt;
+        krt.build(n, tree.size(), [&](size_t k) { return edges[tree[k]]; });
+        answer_queries(krt, in, binary, opt.threads);
+        return 0;
+    }
 
-        // If nodes are in different connected components of the original graph,
-        // the edge bridges them and is definitely in the MST.
-        if (component[u] != component[v]) {
-            cout << "Yes\n";
-        } else {
-            // Check the max weight on the existing path
-            int max_path_weight = get_max_on_path(u, v);
-            
-            // If new edge is cheaper or equal, it can replace the heaviest edge
-            if (w <= max_path_weight) {
-                cout << "Yes\n";
-            } else {
-                cout << "No\n";
-            }
-        }
+    CSRGraph<int> mst_adj; // Arc data is the edge weight
+    mst_adj.build(n + 1, tree.size(), [&](size_t k) {
+        const Edge& e = edges[tree[k]];
+        return CSREdge<int>{e.u, e.v, e.w};
+    });
+    if (index == "hld") {
+        HeavyLight<int> hld;
+        hld.build(n, mst_adj);
+        answer_queries(hld, in, binary, opt.threads);
+    } else {
+        if (index != "lifting") cerr << "unknown path-max index '" << index << "', using lifting\n";
+        BinaryLifting<int> lift;
+        lift.build(n, mst_adj);
+        if (save_path && !save_index(save_path, lift)) return 1;
+        answer_queries(lift, in, binary, opt.threads);
     }
 
     return 0;
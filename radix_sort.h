@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+
+// Parallel LSD radix sort for edge lists.
+//
+// Edges are sorted by an integer or floating point weight, ascending or
+// descending. The sort is stable: edges with equal weight keep their input
+// order, so Kruskal picks the same tree on every run and every machine.
+//
+// Usage:
+//   radix_sort_edges(edges, [](const Edge& e) { return e.w; });        // ascending
+//   radix_sort_edges(edges, [](const Edge& e) { return e.w; }, true);  // descending
+
+// Order-preserving map from a weight to an unsigned key:
+// a < b  <=>  radix_key(a) < radix_key(b)
+template <typename W>
+auto radix_key(W w) {
+    if constexpr (std::is_floating_point_v<W>) {
+        static_assert(sizeof(W) == 8 || sizeof(W) == 4, "unsupported floating point weight");
+        using U = std::conditional_t<sizeof(W) == 8, uint64_t, uint32_t>;
+        U bits;
+        std::memcpy(&bits, &w, sizeof(W));
+        const U sign = U(1) << (sizeof(W) * 8 - 1);
+        // Negative values: flip everything (larger magnitude sorts lower)
+        // Positive values: set the sign bit so they sort above all negatives
+        return (bits & sign) ? U(~bits) : U(bits | sign);
+    } else {
+        static_assert(std::is_integral_v<W>, "weights must be integral or floating point");
+        using U = std::conditional_t<sizeof(W) <= 4, uint32_t, uint64_t>;
+        if constexpr (std::is_signed_v<W>) {
+            return U(static_cast<std::make_unsigned_t<W>>(w)) ^ (U(1) << (sizeof(W) * 8 - 1));
+        } else {
+            return U(w);
+        }
+    }
+}
+
+template <typename Key>
+struct RadixItem {
+    Key key;
+    uint32_t idx; // Position of the edge in the input
+};
+
+// Sort items by key, 8 bits per pass. Each thread histograms and scatters its
+// own contiguous chunk; offsets are laid out digit-major, thread-minor, which
+// keeps every pass stable.
+template <typename Key>
+void radix_sort_items(std::vector<RadixItem<Key>>& items, unsigned num_threads) {
+    const std::size_t n = items.size();
+    std::vector<RadixItem<Key>> buffer(n);
+    std::vector<std::array<std::size_t, 256>> count(num_threads);
+
+    for (unsigned shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+        parallel_chunks(n, num_threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+            auto& c = count[t];
+            c.fill(0);
+            for (std::size_t i = begin; i < end; i++) c[(items[i].key >> shift) & 255]++;
+        });
+
+        // Skip the pass if every key has the same digit here (common for
+        // the high bytes of small weights)
+        bool trivial = false;
+        for (int d = 0; d < 256 && !trivial; d++) {
+            std::size_t total = 0;
+            for (unsigned t = 0; t < num_threads; t++) total += count[t][d];
+            if (total == n) trivial = true;
+            else if (total != 0) break;
+        }
+        if (trivial) continue;
+
+        std::size_t sum = 0;
+        for (int d = 0; d < 256; d++) {
+            for (unsigned t = 0; t < num_threads; t++) {
+                std::size_t c = count[t][d];
+                count[t][d] = sum;
+                sum += c;
+            }
+        }
+
+        parallel_chunks(n, num_threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+            auto& offset = count[t];
+            for (std::size_t i = begin; i < end; i++) {
+                buffer[offset[(items[i].key >> shift) & 255]++] = items[i];
+            }
+        });
+        items.swap(buffer);
+    }
+}
+
+// Stable order of positions 0..n-1 by key_of(position)
+template <typename Key, typename KeyOf>
+std::vector<uint32_t> radix_sort_keys(std::size_t n, KeyOf key_of, unsigned threads) {
+    std::vector<RadixItem<Key>> items(n);
+    parallel_for(n, threads, [&](std::size_t i) { items[i] = {key_of(i), static_cast<uint32_t>(i)}; });
+
+    radix_sort_items(items, threads);
+
+    std::vector<uint32_t> order(n);
+    parallel_for(n, threads, [&](std::size_t i) { order[i] = items[i].idx; });
+    return order;
+}
+
+// Stable permutation that sorts edges by weight_of(edge): result[i] is the
+// input position of the i-th edge in sorted order. Edges can be any container
+// with size() and operator[] (a vector of structs, or a columnar EdgeStore).
+template <typename Edges, typename WeightOf>
+std::vector<uint32_t> radix_sort_order(const Edges& edges, WeightOf weight_of,
+                                       bool descending = false, unsigned num_threads = 0) {
+    using W = std::decay_t<decltype(weight_of(edges[0]))>;
+    using Key = decltype(radix_key(W{}));
+
+    const std::size_t n = edges.size();
+    const unsigned threads = resolve_thread_count(n, num_threads, 1 << 16);
+
+    auto key_of = [&](std::size_t i) {
+        Key key = radix_key(weight_of(edges[i]));
+        return descending ? Key(~key) : key;
+    };
+
+    if constexpr (sizeof(Key) == 8) {
+        // 64-bit weights usually span far less than 2^32 (e.g. long long
+        // weights up to 1e9). Sorting key - min as a 32-bit key halves the
+        // size of the items and of the scatter buffer.
+        std::vector<Key> lo(threads, ~Key(0)), hi(threads, 0);
+        parallel_chunks(n, threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                Key key = key_of(i);
+                if (key < lo[t]) lo[t] = key;
+                if (key > hi[t]) hi[t] = key;
+            }
+        });
+        Key min = ~Key(0), max = 0;
+        for (unsigned t = 0; t < threads; t++) {
+            if (lo[t] < min) min = lo[t];
+            if (hi[t] > max) max = hi[t];
+        }
+        if (n > 0 && max - min <= UINT32_MAX) {
+            return radix_sort_keys<uint32_t>(n, [&](std::size_t i) { return uint32_t(key_of(i) - min); }, threads);
+        }
+    }
+    return radix_sort_keys<Key>(n, key_of, threads);
+}
+
+// Sort edges in place by weight_of(edge) (stable)
+template <typename E, typename WeightOf>
+void radix_sort_edges(std::vector<E>& edges, WeightOf weight_of, bool descending = false, unsigned num_threads = 0) {
+    const std::size_t n = edges.size();
+    const unsigned threads = resolve_thread_count(n, num_threads, 1 << 16);
+
+    std::vector<uint32_t> order = radix_sort_order(edges, weight_of, descending, threads);
+
+    std::vector<E> sorted(n);
+    parallel_for(n, threads, [&](std::size_t i) { sorted[i] = std::move(edges[order[i]]); });
+    edges.swap(sorted);
+}
@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <iomanip> // Required for setprecision
 
+#include "dsu.h"
+#include "edge_input.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 const double INF = 1e18; // Use a very large number for double comparison
@@ -12,52 +16,12 @@ struct Edge {
     double w; // Changed to double for ratio calculation
 };
 
-bool comparator(const Edge &a, const Edge &b) {
-    return a.w < b.w;
-}
-
-struct DSU {
-    vector<int> parent, rnk;
-    int num_components; // [ADDED] To track connectivity
-
-    DSU(int n) {
-        // [MODIFIED] Resize to n+1 to handle 1-based indexing safely
-        parent.resize(n + 1);
-        rnk.assign(n + 1, 0);
-        num_components = n; // Initially N disjoint components
-        for (int i = 0; i <= n; i++) { 
-            parent[i] = i;
-        }
-    }
-
-    int find_set(int v) {
-        if (parent[v] == v) return v;
-        else return parent[v] = find_set(parent[v]);
-    }
-
-    bool unite(int a, int b) {
-        a = find_set(a);
-        b = find_set(b);
-        if (a == b) return false;
-        
-        // [ADDED] Decrease component count on successful merge
-        num_components--; 
-
-        if (rnk[a] < rnk[b]) {
-            swap(a, b);
-        }
-        parent[b] = a;
-        if (rnk[a] == rnk[b]) rnk[a]++;
-        return true;
-    }
-};
-
 // [NEW] Logic for Minimum Ratio Problem
 void solve_min_ratio(int n, vector<Edge> &edges) {
     int m = edges.size();
     
     // Step 1: Sort edges by weight (diameter)
-    sort(edges.begin(), edges.end(), comparator);
+    radix_sort_edges(edges, [](const Edge& e) { return e.w; });
 
     double min_ratio = INF;
     bool found = false;
@@ -94,33 +58,22 @@ void solve_min_ratio(int n, vector<Edge> &edges) {
 
     if (found) {
         // Output with precision (usually required for ratio problems)
-        cout << fixed << setprecision(3) << min_ratio << endl;
+        cout << fixed << setprecision(3) << min_ratio << "\n";
     } else {
-        cout << "-1" << endl;
+        cout << "-1\n";
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Fast I/O
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n, m;
-    if (!(cin >> n >> m)) return 0;
-
-    vector<Edge> edges(m);
-
-    for (int i = 0; i < m; i++) {
-        int u, v;
-        double w;
-        cin >> u >> v >> w;
-        
-        Edge e;
-        e.u = u;
-        e.v = v;
-        e.w = w;
-        edges[i] = e;
-    }
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
+    int n;
+    vector<Edge> edges;
+    // "n m" + edges from stdin, or a binary graph file with --graph=path
+    if (!read_graph(in, argc, argv, n, edges)) return 0;
     
     // Call the specific solver
     solve_min_ratio(n, edges);
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <iomanip>
 
+#include "dsu.h"
+#include "fast_input.h"
+#include "radix_sort.h"
+
 using namespace std;
 
 // Structure to represent a town's coordinates
@@ -16,58 +20,22 @@ struct Edge {
     int u, v;       // The indices of the two towns
     double weight;  // The calculated cost (distance * U or V)
     bool is_utp;    // True if UTP, False if Fiber
-
-    // Overload < operator for sorting edges by weight
-    bool operator<(const Edge& other) const {
-        return weight < other.weight;
-    }
-};
-
-// Disjoint Set Union (DSU) structure for Kruskal's Algorithm
-struct DSU {
-    vector<int> parent;
-    int num_components;
-
-    DSU(int n) {
-        parent.resize(n);
-        for (int i = 0; i < n; i++) {
-            parent[i] = i;
-        }
-        num_components = n;
-    }
-
-    int find(int i) {
-        if (parent[i] == i)
-            return i;
-        return parent[i] = find(parent[i]);
-    }
-
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if (root_i != root_j) {
-            parent[root_i] = root_j;
-            num_components--;
-        }
-    }
 };
 
 double get_dist(Point p1, Point p2) {
     return sqrt(pow(p1.x - p2.x, 2) + pow(p1.y - p2.y, 2));
 }
 
-void solve(int tc) {
+void solve(FastInput& in, int tc) {
     int N, R, W, U, V;
-    if (!(cin >> N >> R >> W >> U >> V)) return;
+    if (!in.read(N, R, W, U, V)) return;
 
     vector<Point> towns(N);
-    for (int i = 0; i < N; i++) {
-        cin >> towns[i].x >> towns[i].y;
-    }
+    in.read_records<int, int>(N, [&](size_t i, int x, int y) { towns[i] = {x, y}; });
 
     // Edge case: If we have enough modems for every town, cost is 0
     if (W >= N) {
-        cout << "Caso #" << tc << ": 0.000 0.000" << endl;
+        cout << "Caso #" << tc << ": 0.000 0.000\n";
         return;
     }
 
@@ -93,7 +61,7 @@ void solve(int tc) {
     }
 
     // Sort edges by cost (Kruskal's greedy step)
-    sort(edges.begin(), edges.end());
+    radix_sort_edges(edges, [](const Edge& e) { return e.weight; });
 
     DSU dsu(N);
     double cost_utp = 0;
@@ -119,14 +87,18 @@ void solve(int tc) {
 
     cout << "Caso #" << tc << ": " 
          << fixed << setprecision(3) << cost_utp << " " 
-         << cost_fiber << endl;
+         << cost_fiber << "\n";
 }
 
-int main() {
+int main(int argc, char** argv) {
+    ios_base::sync_with_stdio(false);
+    cin.tie(NULL);
+
+    FastInput in(argc, argv); // All of stdin (or --input=path) in one go
     int t;
-    if (cin >> t) {
+    if (in.read(t)) {
         for (int i = 1; i <= t; i++) {
-            solve(i);
+            solve(in, i);
         }
     }
     return 0;
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "dynamic_mst.h"
+
+using namespace std;
+
+// Regression test for dynamic_mst.h's cut sketches
+// Usage: test_dynamic_mst   (exit code 0 = pass)
+//
+// Sketch tags used to be splitmix64 of the edge id alone, so an input could
+// place parallel edges at ids whose tags XOR to 0: the sketch of the cut then
+// read 0 for their bucket and a raised tree edge kept its place instead of
+// being replaced. This builds such an input, solving for the cancelling ids
+// against the old unkeyed tags, and checks that the replacement is found.
+
+// The old, unkeyed tag of edge id
+static uint64_t unkeyed_tag(uint32_t id) {
+    uint64_t z = (static_cast<uint64_t>(id) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Ids among 1..65 whose unkeyed tags XOR to 0 (65 vectors in GF(2)^64 are
+// always dependent), by Gaussian elimination that tracks each row's ids
+static vector<uint32_t> cancelling_ids() {
+    const int CANDIDATES = 65;
+    vector<uint64_t> basis(64, 0);
+    vector<vector<bool>> uses(64, vector<bool>(CANDIDATES + 1, false));
+    for (uint32_t id = 1; id <= CANDIDATES; id++) {
+        uint64_t x = unkeyed_tag(id);
+        vector<bool> used(CANDIDATES + 1, false);
+        used[id] = true;
+        for (int bit = 63; bit >= 0; bit--) {
+            if (!(x >> bit & 1)) continue;
+            if (!basis[bit]) {
+                basis[bit] = x;
+                uses[bit] = used;
+                break;
+            }
+            x ^= basis[bit];
+            for (int k = 0; k <= CANDIDATES; k++) used[k] = used[k] != uses[bit][k];
+        }
+        if (x) continue; // Joined the basis
+        vector<uint32_t> ids;
+        for (uint32_t k = 1; k <= CANDIDATES; k++) {
+            if (used[k]) ids.push_back(k);
+        }
+        return ids;
+    }
+    return {};
+}
+
+int main() {
+    vector<uint32_t> ids = cancelling_ids();
+    uint64_t sum = 0;
+    for (uint32_t id : ids) sum ^= unkeyed_tag(id);
+    if (ids.empty() || sum != 0) {
+        cerr << "FAIL: no cancelling set found\n";
+        return 1;
+    }
+
+    // Edge 0 is the tree edge 1-2; the cancelling ids are parallel 1-2 edges
+    // of weight 10, every other id a self-loop that no cut ever sees
+    EdgeStore<long long> edges;
+    vector<bool> parallel(ids.back() + 1, false);
+    for (uint32_t id : ids) parallel[id] = true;
+    edges.push_back(1, 2, 1);
+    for (uint32_t id = 1; id <= ids.back(); id++) {
+        if (parallel[id]) edges.push_back(1, 2, 10);
+        else edges.push_back(1, 1, 1000);
+    }
+
+    DynamicMST<long long> mst;
+    mst.init(2, std::move(edges), {0});
+    mst.set_weight(0, 101);
+
+    cout << ids.size() << " parallel edges with cancelling unkeyed tags, forest weight " << mst.weight << "\n";
+    if (mst.weight != 10) {
+        cerr << "FAIL: expected 10\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Unix domain stream sockets for the local query server and its clients.
+// Errors are reported on stderr and the calls return -1 / false.
+
+inline bool unix_address(const char* path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(addr.sun_path)) {
+        std::cerr << "socket path too long '" << path << "'\n";
+        return false;
+    }
+    std::strcpy(addr.sun_path, path);
+    return true;
+}
+
+// Listening socket at path (a stale socket file there is replaced)
+inline int listen_unix(const char* path) {
+    sockaddr_un addr;
+    if (!unix_address(path, addr)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "cannot create socket: " << std::strerror(errno) << "\n";
+        return -1;
+    }
+    ::unlink(path);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "cannot listen on '" << path << "': " << std::strerror(errno) << "\n";
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+inline int connect_unix(const char* path) {
+    sockaddr_un addr;
+    if (!unix_address(path, addr)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "cannot connect to '" << path << "': " << std::strerror(errno) << "\n";
+        if (fd >= 0) ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Blocking write of the whole buffer; false if the peer went away
+inline bool write_all(int fd, const char* data, std::size_t len) {
+    while (len > 0) {
+        ssize_t wrote = ::write(fd, data, len);
+        if (wrote < 0 && errno == EINTR) continue;
+        if (wrote <= 0) return false;
+        data += wrote;
+        len -= static_cast<std::size_t>(wrote);
+    }
+    return true;
+}